@@ -1,12 +1,24 @@
+#include "frozen_map.hpp"
+#include "lookup_table.hpp"
+#include "unique_stats.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <array>
 #include <ranges>
 #include <algorithm>
+#include <bit>
+#include <cstdint>
 #include <numeric>
+#include <random>
+#include <span>
+#include <sstream>
 
 using namespace std::literals;
 
@@ -141,9 +153,20 @@ constexpr auto avg_for_unique(const TRng_&... rng)
 {
     using TElement = std::common_type_t<std::ranges::range_value_t<TRng_>...>;
 
+    // sorted inputs - k-way merge, no buffer
+    if constexpr ((std::ranges::forward_range<const TRng_> && ...))
+    {
+        if ((std::ranges::is_sorted(rng) && ...))
+            return ct::unique_stats_of_sorted<TElement>(rng...).mean();
+    }
+
+    // unsorted inputs at runtime - hash set of the distinct values
+    if (!std::is_constant_evaluated())
+        return ct::unique_stats_of_unsorted<TElement>(rng...).mean();
+
     std::vector<TElement> vec;                            // empty vector
-    vec.reserve((rng.size() + ...));                      // reserve a buffer - fold expression C++17
-    (vec.insert(vec.end(), rng.begin(), rng.end()), ...); // fold expression C++17
+    vec.reserve((std::ranges::size(rng) + ...));          // reserve a buffer - fold expression C++17
+    (vec.insert(vec.end(), std::ranges::begin(rng), std::ranges::end(rng)), ...); // fold expression C++17
 
     // sort items
     std::ranges::sort(vec); // std::sort(vec.begin(), vec.end());
@@ -164,8 +187,69 @@ TEST_CASE("avg for unique")
     constexpr std::array lst2 = {5, 6, 7, 8, 9};
 
     constexpr auto avg = avg_for_unique(lst1, lst2);
+    static_assert(avg == 5.0);
 
     std::cout << "AVG: " << avg << "\n";
+
+    SECTION("unsorted input")
+    {
+        constexpr std::array lst3 = {9, 1, 5, 1};
+        constexpr std::array lst4 = {7, 5, 3};
+
+        static_assert(avg_for_unique(lst3, lst4) == 5.0); // sort & unique at compile time
+        REQUIRE(avg_for_unique(lst3, lst4) == 5.0);       // hash set at runtime
+    }
+
+    SECTION("mixed element types")
+    {
+        const std::vector<double> lst3 = {0.5, 1.5, 1.5};
+        const std::vector<int> lst4 = {1, 2};
+
+        REQUIRE(avg_for_unique(lst3, lst4) == 1.25);
+    }
+
+    SECTION("streaming accumulator")
+    {
+        constexpr auto stats = [] {
+            ct::UniqueStats<int> stats;
+            for (int x : {1, 1, 2, 3, 3, 3, 10})
+                stats.add(x);
+            return stats;
+        }();
+
+        static_assert(stats.count() == 4);
+        static_assert(stats.sum() == 16);
+        static_assert(stats.mean() == 4.0);
+    }
+}
+
+TEST_CASE("avg for unique - sorted vs unsorted inputs", "[.][benchmark]")
+{
+    std::vector<int> lst1(10'000'000);
+    std::vector<int> lst2(10'000'000);
+    std::iota(lst1.begin(), lst1.end(), 0);
+    std::iota(lst2.begin(), lst2.end(), 5'000'000);
+
+    BENCHMARK("concatenate, sort & unique")
+    {
+        std::vector<int> vec(lst1.begin(), lst1.end());
+        vec.insert(vec.end(), lst2.begin(), lst2.end());
+        std::ranges::sort(vec);
+        auto unique_items = std::ranges::subrange{vec.begin(), std::unique(vec.begin(), vec.end())};
+        return std::accumulate(unique_items.begin(), unique_items.end(), 0L) / static_cast<double>(unique_items.size());
+    };
+
+    BENCHMARK("sorted - k-way merge")
+    {
+        return avg_for_unique(lst1, lst2);
+    };
+
+    std::ranges::reverse(lst2);
+
+    BENCHMARK("unsorted - hash set")
+    {
+        return avg_for_unique(lst1, lst2);
+    };
 }
 
 template <size_t FIB_AMOUNT = 100>
@@ -211,4 +295,207 @@ TEST_CASE("Exercise - Fibonacci lookup table - 1..100")
             return n;
         return fibonacci(n-1) + fibonacci(n-2);
     });
-}
\ No newline at end of file
+}
+
+struct DivMod
+{
+    int quot;
+    int rem;
+};
+
+TEST_CASE("generic lookup tables")
+{
+    SECTION("element type deduced from the generator")
+    {
+        constexpr auto factorials = ct::make_lookup_table<21>([](std::size_t n) { return factorial(n); });
+        static_assert(std::same_as<decltype(factorials), const std::array<uintmax_t, 21>>);
+        static_assert(factorials[20] == 2'432'902'008'176'640'000);
+
+        constexpr auto fibonacci_numbers = ct::make_lookup_table<93>([](std::size_t n) { return generate_fibonacci<93>()[n]; });
+        static_assert(fibonacci_numbers[92] == 7'540'113'804'746'346'429);
+    }
+
+    SECTION("64K entries")
+    {
+        constexpr auto popcounts = ct::make_lookup_table<65'536>([](std::size_t i) { return static_cast<std::uint8_t>(std::popcount(i)); });
+        static_assert(popcounts.size() == 65'536);
+        static_assert(popcounts[0xFFFF] == 16);
+
+        REQUIRE(popcounts[0b1011] == 3);
+    }
+
+    SECTION("2-D table")
+    {
+        constexpr auto saturated_add = ct::make_lookup_table<256, 256>([](std::size_t a, std::size_t b) {
+            return static_cast<std::uint8_t>(std::min<std::size_t>(a + b, 255));
+        });
+        static_assert(saturated_add[200][100] == 255);
+
+        REQUIRE(saturated_add[3][4] == 7);
+    }
+
+    SECTION("table of structs")
+    {
+        constexpr auto div_mod_10 = ct::make_lookup_table<100>([](std::size_t i) {
+            return DivMod{static_cast<int>(i / 10), static_cast<int>(i % 10)};
+        });
+        static_assert(div_mod_10[42].quot == 4 && div_mod_10[42].rem == 2);
+    }
+
+    SECTION("table emitted as a header")
+    {
+        std::ostringstream header;
+
+        ct::emit_lookup_table(header, "double", "halves", ct::make_lookup_table<3>([](std::size_t i) { return i / 2.0; }));
+        ct::emit_lookup_table(header, "int", "products", ct::make_lookup_table<2, 2>([](std::size_t a, std::size_t b) { return static_cast<int>(a * b); }));
+        ct::emit_lookup_table(header, "DivMod", "div_mod_10", ct::make_lookup_table<2>([](std::size_t i) { return DivMod{0, static_cast<int>(i)}; }),
+            [](std::ostream& out, const DivMod& dm) { out << '{' << dm.quot << ", " << dm.rem << '}'; });
+
+        REQUIRE(header.str() ==
+            "inline constexpr std::array<double, 3> halves = {{0.0, 0.5, 1.0}};\n"
+            "inline constexpr std::array<std::array<int, 2>, 2> products = {{{{0, 0}},\n{{0, 1}}}};\n"
+            "inline constexpr std::array<DivMod, 2> div_mod_10 = {{{0, 0}, {0, 1}}};\n");
+    }
+}
+
+int make_circle()
+{
+    return 1;
+}
+
+int make_square()
+{
+    return 2;
+}
+
+int make_triangle()
+{
+    return 3;
+}
+
+TEST_CASE("frozen map")
+{
+    using Creator = int (*)();
+
+    constexpr auto creators = ct::make_frozen_map<std::string_view, Creator>({
+        {"circle", &make_circle},
+        {"square", &make_square},
+        {"triangle", &make_triangle},
+    });
+
+    static_assert(creators.size() == 3);
+    static_assert(creators.contains("square"));
+    static_assert(!creators.contains("rectangle"));
+    static_assert(!creators.contains(""));
+    static_assert(creators.at("triangle") == &make_triangle);
+
+    SECTION("runtime keys")
+    {
+        std::string key = "circle";
+        REQUIRE(creators.at(key)() == 1);
+        REQUIRE(creators.find(key)->first == "circle");
+
+        key = "circles";
+        REQUIRE(creators.find(key) == creators.end());
+        REQUIRE_THROWS_AS(creators.at(key), std::out_of_range);
+    }
+
+    SECTION("iteration in the order of the list")
+    {
+        std::vector<std::string_view> keys;
+        for (const auto& [name, creator] : creators)
+            keys.push_back(name);
+
+        REQUIRE(keys == std::vector{"circle"sv, "square"sv, "triangle"sv});
+    }
+
+    SECTION("keys longer than 8 characters")
+    {
+        constexpr auto levels = ct::make_frozen_map<std::string_view, int>({
+            {"verbose-diagnostics", 0},
+            {"verbose-diagnostic", 1},
+            {"verbose-diagnostics-all", 2},
+            {"v", 3},
+        });
+
+        static_assert(levels.at("verbose-diagnostics") == 0);
+        static_assert(levels.at("verbose-diagnostic") == 1);
+        static_assert(levels.at("verbose-diagnostics-all") == 2);
+        static_assert(levels.at("v") == 3);
+        static_assert(!levels.contains("verbose-diagnostics-al"));
+    }
+
+    SECTION("duplicate keys rejected - at compile time the initialization is not a constant expression")
+    {
+        std::array<std::pair<std::string_view, int>, 3> items{{{"one", 1}, {"two", 2}, {"one", 3}}};
+
+        REQUIRE_THROWS_AS((ct::FrozenMap<std::string_view, int, 3>{items}), std::invalid_argument);
+    }
+}
+
+namespace
+{
+    // "key-0", "key-1", ... in static storage - referenced by string_views of a constexpr FrozenMap
+    template <std::size_t N>
+    constexpr auto key_texts = ct::make_lookup_table<N>([](std::size_t i) {
+        std::array<char, 12> text{'k', 'e', 'y', '-'};
+        std::size_t length = 4;
+        for (std::size_t n = i; length == 4 || n > 0; n /= 10)
+            text[length++] = static_cast<char>('0' + n % 10);
+        std::reverse(text.begin() + 4, text.begin() + length);
+        return text;
+    });
+
+    template <std::size_t N>
+    constexpr auto numbered_items()
+    {
+        std::array<std::pair<std::string_view, int>, N> items{};
+        for (std::size_t i = 0; i < N; ++i)
+            items[i] = {std::string_view{key_texts<N>[i].data()}, static_cast<int>(i)};
+        return items;
+    }
+
+    template <std::size_t N>
+    constexpr ct::FrozenMap<std::string_view, int, N> numbered_frozen_map{numbered_items<N>()};
+
+    template <std::size_t N>
+    void benchmark_lookups()
+    {
+        constexpr auto& frozen = numbered_frozen_map<N>;
+        static_assert(frozen.at("key-0") == 0);
+
+        const auto items = numbered_items<N>();
+        std::unordered_map<std::string_view, int> hashed(items.begin(), items.end());
+
+        std::vector<std::string> queries;
+        for (const auto& [key, value] : items)
+            queries.emplace_back(key);
+        std::ranges::shuffle(queries, std::mt19937{42});
+
+        for (const auto& query : queries)
+            REQUIRE(frozen.at(query) == hashed.at(query));
+
+        BENCHMARK("std::unordered_map - " + std::to_string(N) + " keys")
+        {
+            long sum = 0;
+            for (const auto& query : queries)
+                sum += hashed.find(query)->second;
+            return sum;
+        };
+
+        BENCHMARK("ct::FrozenMap - " + std::to_string(N) + " keys")
+        {
+            long sum = 0;
+            for (const auto& query : queries)
+                sum += frozen.find(query)->second;
+            return sum;
+        };
+    }
+} // namespace
+
+TEST_CASE("frozen map vs. std::unordered_map - lookups", "[.][benchmark]")
+{
+    benchmark_lookups<100>();
+    benchmark_lookups<1'000>();
+    benchmark_lookups<10'000>();
+}
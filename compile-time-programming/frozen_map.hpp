@@ -0,0 +1,247 @@
+#ifndef FROZEN_MAP_HPP
+#define FROZEN_MAP_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ct
+{
+    namespace detail
+    {
+        constexpr std::uint64_t mix(std::uint64_t x) noexcept
+        {
+            x ^= x >> 32;
+            x *= 0xD6E8FEB86659FD93ULL;
+            x ^= x >> 32;
+            return x;
+        }
+
+        // 8 bytes at a time - the byte loop is folded into a single load by the optimizer
+        constexpr std::uint64_t hash(std::string_view text, std::uint64_t seed) noexcept
+        {
+            constexpr std::uint64_t prime = 0x9E3779B97F4A7C15ULL;
+
+            std::uint64_t h = seed ^ (text.size() * prime);
+            std::size_t i = 0;
+            for (; i + 8 <= text.size(); i += 8)
+            {
+                std::uint64_t chunk = 0;
+                for (std::size_t k = 0; k < 8; ++k)
+                    chunk |= std::uint64_t{static_cast<unsigned char>(text[i + k])} << (8 * k);
+                h = (h ^ mix(chunk)) * prime;
+            }
+
+            std::uint64_t tail = 0;
+            for (std::size_t k = 0; i + k < text.size(); ++k)
+                tail |= std::uint64_t{static_cast<unsigned char>(text[i + k])} << (8 * k);
+
+            return mix((h ^ tail) * prime);
+        }
+    } // namespace detail
+
+    // read-only map with a perfect hash built at compile time ("hash and displace"):
+    // keys are hashed once; the upper half of the hash selects a bucket, the displacement of the bucket
+    // mixed with the hash selects the slot - different for every key, so a lookup is one hash and one comparison;
+    // about 10'000 short keys fit the default constant evaluation limits of GCC (-fconstexpr-ops-limit)
+    //   constexpr auto creators = ct::make_frozen_map<std::string_view, Creator>({{"circle", &make_circle}, ...});
+    template <typename Key, typename Value, std::size_t N>
+        requires std::convertible_to<const Key&, std::string_view>
+    class FrozenMap
+    {
+        static_assert(N > 0, "FrozenMap needs at least one key");
+
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using const_iterator = typename std::array<value_type, N>::const_iterator;
+
+        // load of the slot table between 3/8 and 3/4, four keys per bucket on average
+        static constexpr std::size_t slot_count = std::bit_ceil(N) * (N > std::bit_ceil(N) / 4 * 3 ? 2 : 1);
+        static constexpr std::size_t bucket_count = N / 4 + 1;
+
+        constexpr explicit FrozenMap(const std::array<value_type, N>& items)
+            : items_{items}
+        {
+            for (std::uint64_t seed = 0x5EED;; seed = detail::mix(seed + 1))
+            {
+                if (try_build(seed))
+                    return;
+            }
+        }
+
+        constexpr std::size_t size() const noexcept
+        {
+            return N;
+        }
+
+        constexpr const_iterator begin() const noexcept
+        {
+            return items_.begin();
+        }
+
+        constexpr const_iterator end() const noexcept
+        {
+            return items_.end();
+        }
+
+        constexpr const_iterator find(std::string_view key) const noexcept
+        {
+            const auto index = index_[slot_of(detail::hash(key, seed_))];
+            return std::string_view{items_[index].first} == key ? items_.begin() + index : items_.end();
+        }
+
+        constexpr bool contains(std::string_view key) const noexcept
+        {
+            return find(key) != end();
+        }
+
+        constexpr const Value& at(std::string_view key) const
+        {
+            const auto it = find(key);
+            if (it == end())
+                throw std::out_of_range{"FrozenMap: key not found"};
+            return it->second;
+        }
+
+    private:
+        using Index = std::conditional_t<(N <= std::numeric_limits<std::uint16_t>::max()), std::uint16_t, std::uint32_t>;
+
+        std::array<value_type, N> items_;
+        std::array<Index, slot_count> index_{}; // empty slots point to any item - the comparison rejects it
+        std::array<std::uint32_t, bucket_count> displacements_{};
+        std::uint64_t seed_ = 0;
+
+        static constexpr std::size_t bucket_of(std::uint64_t h) noexcept
+        {
+            return static_cast<std::size_t>(((h >> 32) * bucket_count) >> 32);
+        }
+
+        static constexpr std::size_t slot_of(std::uint64_t h, std::uint32_t displacement) noexcept
+        {
+            return static_cast<std::size_t>(detail::mix(h ^ (displacement * 0x9E3779B97F4A7C15ULL)) & (slot_count - 1));
+        }
+
+        constexpr std::size_t slot_of(std::uint64_t h) const noexcept
+        {
+            return slot_of(h, displacements_[bucket_of(h)]);
+        }
+
+        // false if the seed does not work - equal hashes or a bucket that cannot be placed
+        constexpr bool try_build(std::uint64_t seed)
+        {
+            std::vector<std::uint64_t> hashes(N);
+            for (std::size_t i = 0; i < N; ++i)
+                hashes[i] = detail::hash(items_[i].first, seed);
+
+            // keys grouped by bucket (counting sort) - keys with equal hashes end up in the same bucket
+            std::vector<std::size_t> starts(bucket_count + 1, 0);
+            for (std::size_t i = 0; i < N; ++i)
+                ++starts[bucket_of(hashes[i]) + 1];
+
+            std::size_t largest = 0;
+            for (std::size_t b = 0; b < bucket_count; ++b)
+            {
+                largest = std::max(largest, starts[b + 1]);
+                starts[b + 1] += starts[b];
+            }
+
+            // members of a bucket and their hashes stored next to each other
+            std::vector<std::size_t> members(N);
+            std::vector<std::uint64_t> member_hashes(N);
+            std::vector<std::size_t> fill(starts.begin(), starts.end() - 1);
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                const std::size_t position = fill[bucket_of(hashes[i])]++;
+                members[position] = i;
+                member_hashes[position] = hashes[i];
+            }
+
+            // the largest buckets placed first, while most of the slots are free
+            std::vector<std::size_t> order_starts(largest + 2, 0);
+            for (std::size_t b = 0; b < bucket_count; ++b)
+                ++order_starts[largest - (starts[b + 1] - starts[b]) + 1];
+            for (std::size_t k = 0; k <= largest; ++k)
+                order_starts[k + 1] += order_starts[k];
+            std::vector<std::size_t> order(bucket_count);
+            for (std::size_t b = 0; b < bucket_count; ++b)
+                order[order_starts[largest - (starts[b + 1] - starts[b])]++] = b;
+
+            // 1 - slot taken; a slot marked with the number of the current attempt is taken by the bucket being placed
+            std::vector<std::uint32_t> occupied(slot_count, 0);
+            std::uint32_t attempt = 1;
+            for (std::size_t b : order)
+            {
+                const std::size_t first = starts[b];
+                const std::size_t last = starts[b + 1];
+                if (first == last)
+                    break;
+
+                for (std::size_t m = first; m < last; ++m)
+                {
+                    for (std::size_t other = first; other < m; ++other)
+                    {
+                        if (member_hashes[m] != member_hashes[other])
+                            continue;
+                        if (std::string_view{items_[members[m]].first} == std::string_view{items_[members[other]].first})
+                            throw std::invalid_argument{"FrozenMap: duplicate key"};
+                        return false;
+                    }
+                }
+
+                bool placed = false;
+                for (std::uint32_t displacement = 0; displacement < 1u << 16 && !placed; ++displacement)
+                {
+                    ++attempt;
+                    std::size_t m = first;
+                    for (; m < last; ++m)
+                    {
+                        const std::size_t slot = slot_of(member_hashes[m], displacement);
+                        if (occupied[slot] == 1 || occupied[slot] == attempt)
+                            break;
+                        occupied[slot] = attempt;
+                    }
+
+                    if (m == last)
+                    {
+                        for (m = first; m < last; ++m)
+                        {
+                            const std::size_t slot = slot_of(member_hashes[m], displacement);
+                            occupied[slot] = 1;
+                            index_[slot] = static_cast<Index>(members[m]);
+                        }
+                        displacements_[b] = displacement;
+                        placed = true;
+                    }
+                }
+
+                if (!placed)
+                    return false;
+            }
+
+            seed_ = seed;
+            return true;
+        }
+    };
+
+    // N deduced from the list: ct::make_frozen_map<std::string_view, int>({{"one", 1}, {"two", 2}})
+    template <typename Key, typename Value, std::size_t N>
+    constexpr FrozenMap<Key, Value, N> make_frozen_map(const std::pair<Key, Value> (&items)[N])
+    {
+        std::array<std::pair<Key, Value>, N> array{};
+        std::ranges::copy(items, array.begin());
+        return FrozenMap<Key, Value, N>{array};
+    }
+} // namespace ct
+
+#endif
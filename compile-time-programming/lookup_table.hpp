@@ -0,0 +1,121 @@
+#ifndef LOOKUP_TABLE_HPP
+#define LOOKUP_TABLE_HPP
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace ct
+{
+    // table[i] = func(i) - the element type is deduced from the generator; filled with a plain loop,
+    // which keeps constant evaluation of 64K-entry tables within the default compiler limits
+    //   constexpr auto popcounts = ct::make_lookup_table<65536>([](std::size_t i) { return std::popcount(i); });
+    template <std::size_t N, typename F>
+        requires std::invocable<F&, std::size_t> && std::default_initializable<std::invoke_result_t<F&, std::size_t>>
+    constexpr auto make_lookup_table(F func)
+    {
+        std::array<std::invoke_result_t<F&, std::size_t>, N> table{};
+        for (std::size_t i = 0; i < N; ++i)
+            table[i] = func(i);
+        return table;
+    }
+
+    // table[i][j] = func(i, j)
+    template <std::size_t Rows, std::size_t Cols, typename F>
+        requires std::invocable<F&, std::size_t, std::size_t> && std::default_initializable<std::invoke_result_t<F&, std::size_t, std::size_t>>
+    constexpr auto make_lookup_table(F func)
+    {
+        std::array<std::array<std::invoke_result_t<F&, std::size_t, std::size_t>, Cols>, Rows> table{};
+        for (std::size_t i = 0; i < Rows; ++i)
+            for (std::size_t j = 0; j < Cols; ++j)
+                table[i][j] = func(i, j);
+        return table;
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        constexpr bool is_std_array = false;
+
+        template <typename T, std::size_t N>
+        constexpr bool is_std_array<std::array<T, N>> = true;
+
+        // shortest text that reads back as the same value (finite floating point values)
+        struct FormatArithmetic
+        {
+            template <typename T>
+                requires std::is_arithmetic_v<T>
+            void operator()(std::ostream& out, T value) const
+            {
+                if constexpr (std::same_as<T, bool>)
+                    out << (value ? "true" : "false");
+                else
+                {
+                    char buffer[64];
+                    const auto [end, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                    out << std::string_view{buffer, end};
+                    if constexpr (std::unsigned_integral<T>)
+                        out << 'u';
+                    else if constexpr (std::floating_point<T>)
+                    {
+                        if (std::string_view{buffer, end}.find_first_of(".eEn") == std::string_view::npos)
+                            out << ".0";
+                        if constexpr (std::same_as<T, float>)
+                            out << 'f';
+                    }
+                }
+            }
+        };
+
+        template <typename T>
+        std::string array_type_name(std::string_view element_type)
+        {
+            if constexpr (is_std_array<T>)
+                return "std::array<" + array_type_name<typename T::value_type>(element_type) + ", " + std::to_string(std::tuple_size_v<T>) + ">";
+            else
+                return std::string{element_type};
+        }
+
+        // std::arrays in double braces - valid at every level of nesting
+        template <typename T, typename Format>
+        void emit_values(std::ostream& out, const T& value, const Format& format)
+        {
+            if constexpr (is_std_array<T>)
+            {
+                constexpr bool rows = is_std_array<typename T::value_type>;
+
+                out << "{{";
+                for (std::size_t i = 0; i < value.size(); ++i)
+                {
+                    if (i > 0)
+                        out << (rows || i % 16 == 0 ? ",\n" : ", ");
+                    emit_values(out, value[i], format);
+                }
+                out << "}}";
+            }
+            else
+                format(out, value);
+        }
+    } // namespace detail
+
+    // tables too large for constant evaluation are generated by a program run at build time (add_custom_command)
+    // into a header with:
+    //   inline constexpr std::array<element_type, N> name = {{...}};
+    // elements are written by format(out, element) - by default arithmetic values, exactly
+    template <typename Table, typename Format = detail::FormatArithmetic>
+        requires detail::is_std_array<Table>
+    void emit_lookup_table(std::ostream& out, std::string_view element_type, std::string_view name, const Table& table, Format format = {})
+    {
+        out << "inline constexpr " << detail::array_type_name<Table>(element_type) << ' ' << name << " = ";
+        detail::emit_values(out, table, format);
+        out << ";\n";
+    }
+} // namespace ct
+
+#endif
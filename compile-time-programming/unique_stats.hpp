@@ -0,0 +1,123 @@
+#ifndef UNIQUE_STATS_HPP
+#define UNIQUE_STATS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+namespace ct
+{
+    // sum, count & mean of distinct values fed in non-decreasing order - repeated values are skipped on the fly,
+    // nothing is stored; integers are summed in the widest type of the same signedness
+    template <typename T>
+    class UniqueStats
+    {
+    public:
+        using sum_type = std::conditional_t<std::is_integral_v<T>, std::conditional_t<std::is_signed_v<T>, std::intmax_t, std::uintmax_t>, T>;
+
+        constexpr void add(const T& value)
+        {
+            if (count_ > 0 && !(last_ < value))
+                return;
+
+            last_ = value;
+            sum_ += static_cast<sum_type>(value);
+            ++count_;
+        }
+
+        // value not seen before - for unsorted input checked by the caller
+        constexpr void add_distinct(const T& value)
+        {
+            sum_ += static_cast<sum_type>(value);
+            ++count_;
+        }
+
+        constexpr sum_type sum() const noexcept
+        {
+            return sum_;
+        }
+
+        constexpr std::size_t count() const noexcept
+        {
+            return count_;
+        }
+
+        constexpr double mean() const noexcept
+        {
+            return static_cast<double>(sum_) / static_cast<double>(count_);
+        }
+
+    private:
+        T last_{};
+        sum_type sum_{};
+        std::size_t count_ = 0;
+    };
+
+    // k-way merge of sorted ranges - the smallest head is taken and every range is advanced past it,
+    // so duplicates within and across the ranges are dropped without a buffer
+    template <typename T, std::ranges::input_range... Rs>
+    constexpr UniqueStats<T> unique_stats_of_sorted(const Rs&... ranges)
+    {
+        UniqueStats<T> stats;
+        auto cursors = std::tuple{std::pair{std::ranges::begin(ranges), std::ranges::end(ranges)}...};
+
+        while (true)
+        {
+            bool found = false;
+            T smallest{};
+            std::apply(
+                [&](auto&... cursor) {
+                    auto take_smaller = [&](auto& c) {
+                        if (c.first != c.second && (!found || static_cast<T>(*c.first) < smallest))
+                        {
+                            smallest = static_cast<T>(*c.first);
+                            found = true;
+                        }
+                    };
+                    (take_smaller(cursor), ...);
+                },
+                cursors);
+
+            if (!found)
+                return stats;
+
+            stats.add_distinct(smallest);
+
+            std::apply(
+                [&](auto&... cursor) {
+                    auto skip = [&](auto& c) {
+                        while (c.first != c.second && !(smallest < static_cast<T>(*c.first)))
+                            ++c.first;
+                    };
+                    (skip(cursor), ...);
+                },
+                cursors);
+        }
+    }
+
+    // unsorted input - the distinct values are remembered in a hash set, O(number of distinct values) memory
+    template <typename T, std::ranges::input_range... Rs>
+    UniqueStats<T> unique_stats_of_unsorted(const Rs&... ranges)
+    {
+        UniqueStats<T> stats;
+        std::unordered_set<T> seen;
+
+        auto add = [&](const auto& range) {
+            for (const auto& item : range)
+            {
+                if (seen.insert(static_cast<T>(item)).second)
+                    stats.add_distinct(static_cast<T>(item));
+            }
+        };
+        (add(ranges), ...);
+
+        return stats;
+    }
+} // namespace ct
+
+#endif
@@ -0,0 +1,111 @@
+#include "async_generator.hpp"
+#include "task.hpp"
+#include "timer.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    coro::AsyncGenerator<int> ticks(coro::Timer& timer, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            co_await timer.sleep_for(1ms);
+            co_yield i;
+        }
+    }
+
+    coro::AsyncGenerator<std::string> lines_on_pool(helpers::ThreadPool& pool, std::vector<std::string> lines)
+    {
+        for (const auto& line : lines)
+        {
+            co_await pool.schedule();
+            co_yield line; // copied - the producer keeps its own
+        }
+    }
+
+    coro::AsyncGenerator<int> counting(int& produced)
+    {
+        while (true)
+            co_yield produced++;
+    }
+
+    coro::AsyncGenerator<int> failing_after(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            co_yield std::move(i);
+
+        throw std::runtime_error{"producer failed"};
+    }
+
+    template <typename T>
+    coro::Task<std::vector<T>> collect(coro::AsyncGenerator<T> gen)
+    {
+        std::vector<T> items;
+        while (T* item = co_await gen.next())
+            items.push_back(std::move(*item));
+
+        co_return items;
+    }
+} // namespace
+
+TEST_CASE("async generator")
+{
+    SECTION("producer awaits between yields")
+    {
+        coro::Timer timer;
+        REQUIRE(coro::sync_wait(collect(ticks(timer, 5))) == std::vector{0, 1, 2, 3, 4});
+    }
+
+    SECTION("producer hops to a thread pool - the consumer follows it")
+    {
+        helpers::ThreadPool pool{2};
+        auto lines = coro::sync_wait(collect(lines_on_pool(pool, {"one", "two", "three"})));
+        REQUIRE(lines == std::vector<std::string>{"one", "two", "three"});
+    }
+
+    SECTION("backpressure - producer runs only when the consumer pulls")
+    {
+        int produced = 0;
+        auto gen = counting(produced);
+
+        REQUIRE(produced == 0); // lazily started
+
+        auto take_three = [](coro::AsyncGenerator<int>& gen) -> coro::Task<int> {
+            int sum = 0;
+            for (int i = 0; i < 3; ++i)
+                sum += *co_await gen.next();
+            co_return sum;
+        };
+
+        REQUIRE(coro::sync_wait(take_three(gen)) == 0 + 1 + 2);
+        REQUIRE(produced == 3);
+    }
+
+    SECTION("exception thrown by the producer is rethrown from next()")
+    {
+        REQUIRE_THROWS_AS(coro::sync_wait(collect(failing_after(2))), std::runtime_error);
+    }
+
+    SECTION("for_each with an async body")
+    {
+        coro::Timer timer;
+        auto gen = ticks(timer, 3);
+        std::vector<int> seen;
+
+        coro::sync_wait(coro::for_each(gen, [&](int tick) -> coro::Task<> {
+            co_await timer.sleep_for(1ms);
+            seen.push_back(tick);
+        }));
+
+        REQUIRE(seen == std::vector{0, 1, 2});
+    }
+}
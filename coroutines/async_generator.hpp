@@ -0,0 +1,202 @@
+#ifndef ASYNC_GENERATOR_HPP
+#define ASYNC_GENERATOR_HPP
+
+#include "task.hpp"
+
+#include <concepts>
+#include <coroutine>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace coro
+{
+    template <typename T>
+    class AsyncGenerator;
+
+    namespace detail
+    {
+        // producer runs only between next() and the following co_yield - the consumer is its continuation
+        template <typename T>
+        class AsyncGeneratorPromise : public TaskPromiseBase
+        {
+            struct YieldAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<AsyncGeneratorPromise> coro_hndl) noexcept
+                {
+                    return coro_hndl.promise().continuation(); // back to the consumer
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+            // const lvalues are copied into the awaiter - it lives in the producer frame, so no allocation
+            struct CopyingYieldAwaiter : YieldAwaiter
+            {
+                T copy;
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<AsyncGeneratorPromise> coro_hndl) noexcept
+                {
+                    coro_hndl.promise().value_ = std::addressof(copy);
+                    return YieldAwaiter::await_suspend(coro_hndl);
+                }
+            };
+
+        public:
+            AsyncGenerator<T> get_return_object() noexcept;
+
+            YieldAwaiter yield_value(T&& value) noexcept
+            {
+                value_ = std::addressof(value); // the temporary outlives the suspension
+                return {};
+            }
+
+            CopyingYieldAwaiter yield_value(const T& value)
+                requires std::copy_constructible<T>
+            {
+                return CopyingYieldAwaiter{{}, value};
+            }
+
+            void return_void() noexcept
+            {
+                value_ = nullptr;
+            }
+
+            void unhandled_exception() noexcept
+            {
+                value_ = nullptr;
+                eptr_ = std::current_exception();
+            }
+
+            T* value() noexcept
+            {
+                return value_;
+            }
+
+            void rethrow_if_exception()
+            {
+                if (eptr_)
+                    std::rethrow_exception(std::exchange(eptr_, nullptr));
+            }
+
+        private:
+            T* value_ = nullptr;
+            std::exception_ptr eptr_;
+        };
+    } // namespace detail
+
+    // coroutine that can both co_await and co_yield - values are pulled one at a time with co_await gen.next(),
+    // so the producer never runs ahead of the consumer and a single frame is reused for the whole stream
+    template <typename T>
+    class [[nodiscard]] AsyncGenerator
+    {
+    public:
+        using promise_type = detail::AsyncGeneratorPromise<T>;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+        using value_type = T;
+
+    private:
+        struct NextAwaiter
+        {
+            CoroHandle coro_hndl;
+
+            bool await_ready() const noexcept
+            {
+                return !coro_hndl || coro_hndl.done();
+            }
+
+            template <typename TAwaitingPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TAwaitingPromise> awaiting_coro) noexcept
+            {
+                detail::propagate_stop_token(coro_hndl.promise(), awaiting_coro);
+                coro_hndl.promise().set_continuation(awaiting_coro);
+                return coro_hndl;
+            }
+
+            T* await_resume()
+            {
+                if (!coro_hndl)
+                    return nullptr;
+
+                coro_hndl.promise().rethrow_if_exception();
+                return coro_hndl.done() ? nullptr : coro_hndl.promise().value();
+            }
+        };
+
+    public:
+        AsyncGenerator() noexcept = default;
+
+        explicit AsyncGenerator(CoroHandle coro_hndl) noexcept
+            : coro_hndl_{coro_hndl}
+        {
+        }
+
+        AsyncGenerator(const AsyncGenerator&) = delete;
+        AsyncGenerator& operator=(const AsyncGenerator&) = delete;
+
+        AsyncGenerator(AsyncGenerator&& other) noexcept
+            : coro_hndl_{std::exchange(other.coro_hndl_, nullptr)}
+        {
+        }
+
+        AsyncGenerator& operator=(AsyncGenerator&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+                coro_hndl_ = std::exchange(other.coro_hndl_, nullptr);
+            }
+
+            return *this;
+        }
+
+        // a suspended producer is destroyed together with its locals
+        ~AsyncGenerator()
+        {
+            if (coro_hndl_)
+                coro_hndl_.destroy();
+        }
+
+        // co_await gen.next() - resumes the producer until its next co_yield;
+        // returns a pointer to the yielded value (valid until the next call) or nullptr at the end of the stream
+        NextAwaiter next() noexcept
+        {
+            return NextAwaiter{coro_hndl_};
+        }
+
+        // must be called before the first next()
+        void set_stop_token(std::stop_token stop_tkn) noexcept
+        {
+            coro_hndl_.promise().set_stop_token(std::move(stop_tkn));
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+    };
+
+    template <typename T>
+    AsyncGenerator<T> detail::AsyncGeneratorPromise<T>::get_return_object() noexcept
+    {
+        return AsyncGenerator<T>{std::coroutine_handle<AsyncGeneratorPromise>::from_promise(*this)};
+    }
+
+    // for co_await-style loop - f may be a plain function or return an awaitable that is awaited before the next pull
+    template <typename T, std::invocable<T&> F>
+    Task<> for_each(AsyncGenerator<T>& gen, F f)
+    {
+        while (T* value = co_await gen.next())
+        {
+            if constexpr (std::is_void_v<std::invoke_result_t<F&, T&>>)
+                std::invoke(f, *value);
+            else
+                co_await std::invoke(f, *value);
+        }
+    }
+} // namespace coro
+
+#endif
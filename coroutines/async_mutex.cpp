@@ -0,0 +1,289 @@
+#include "async_mutex.hpp"
+#include "async_scope.hpp"
+#include "task.hpp"
+#include "when_all.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int coroutines_count = 64;
+    constexpr int increments_per_coroutine = 1'000;
+
+    coro::Task<> increment_with_async_mutex(helpers::ThreadPool& pool, coro::AsyncMutex& mtx, long& counter)
+    {
+        co_await pool.schedule();
+        for (int i = 0; i < increments_per_coroutine; ++i)
+        {
+            auto lk = co_await mtx.scoped_lock();
+            ++counter;
+        }
+    }
+
+    coro::Task<> increment_with_std_mutex(helpers::ThreadPool& pool, std::mutex& mtx, long& counter)
+    {
+        co_await pool.schedule();
+        for (int i = 0; i < increments_per_coroutine; ++i)
+        {
+            std::lock_guard lk{mtx}; // blocks the worker thread
+            ++counter;
+        }
+    }
+
+    template <typename TIncrement, typename TMutex>
+    long run_contended(helpers::ThreadPool& pool, TMutex& mtx, TIncrement increment)
+    {
+        long counter = 0;
+
+        std::vector<coro::Task<>> tasks;
+        for (int i = 0; i < coroutines_count; ++i)
+            tasks.push_back(increment(pool, mtx, counter));
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+
+        return counter;
+    }
+
+    coro::Task<> record_under_lock(coro::AsyncMutex& mtx, std::vector<int>& order, int id)
+    {
+        auto lk = co_await mtx.scoped_lock();
+        order.push_back(id);
+    }
+} // namespace
+
+TEST_CASE("async mutex")
+{
+    coro::AsyncMutex mtx;
+
+    SECTION("try_lock")
+    {
+        REQUIRE(mtx.try_lock());
+        REQUIRE_FALSE(mtx.try_lock());
+        mtx.unlock();
+        REQUIRE(mtx.try_lock());
+        mtx.unlock();
+    }
+
+    SECTION("uncontended lock does not suspend")
+    {
+        coro::sync_wait([](coro::AsyncMutex& mtx) -> coro::Task<> {
+            auto lk = co_await mtx.scoped_lock();
+        }(mtx));
+
+        REQUIRE(mtx.try_lock());
+        mtx.unlock();
+    }
+
+    SECTION("waiters acquire the lock in FIFO order")
+    {
+        std::vector<int> order;
+
+        REQUIRE(mtx.try_lock());
+
+        coro::AsyncScope scope;
+        for (int id = 0; id < 5; ++id)
+            scope.spawn(record_under_lock(mtx, order, id));
+
+        REQUIRE(order.empty());
+        mtx.unlock(); // each waiter hands the lock off to the next one
+
+        coro::sync_wait(scope.join());
+        REQUIRE(order == std::vector{0, 1, 2, 3, 4});
+    }
+
+    SECTION("long hand-off chain does not nest resumptions")
+    {
+        constexpr int waiters_count = 100'000;
+        int counter = 0;
+
+        REQUIRE(mtx.try_lock());
+
+        coro::AsyncScope scope;
+        for (int i = 0; i < waiters_count; ++i)
+            scope.spawn([](coro::AsyncMutex& mtx, int& counter) -> coro::Task<> {
+                co_await mtx.lock();
+                ++counter;
+                mtx.unlock();
+            }(mtx, counter));
+
+        mtx.unlock();
+        coro::sync_wait(scope.join());
+
+        REQUIRE(counter == waiters_count);
+        REQUIRE(mtx.try_lock());
+        mtx.unlock();
+    }
+
+    SECTION("mutual exclusion under 64 contending coroutines")
+    {
+        helpers::ThreadPool pool{4};
+        REQUIRE(run_contended(pool, mtx, increment_with_async_mutex) == coroutines_count * increments_per_coroutine);
+    }
+
+    SECTION("waiter is resumed on the designated executor")
+    {
+        helpers::ThreadPool pool{1};
+        const auto pool_thread_id = coro::sync_wait([](helpers::ThreadPool& pool) -> coro::Task<std::thread::id> {
+            co_await pool.schedule();
+            co_return std::this_thread::get_id();
+        }(pool));
+
+        REQUIRE(mtx.try_lock());
+
+        std::thread::id resumed_on;
+        coro::AsyncScope scope;
+        scope.spawn([](coro::AsyncMutex& mtx, helpers::ThreadPool& pool, std::thread::id& resumed_on) -> coro::Task<> {
+            auto lk = co_await mtx.scoped_lock(pool);
+            resumed_on = std::this_thread::get_id();
+        }(mtx, pool, resumed_on));
+
+        mtx.unlock();
+        coro::sync_wait(scope.join());
+
+        REQUIRE(resumed_on == pool_thread_id);
+    }
+}
+
+TEST_CASE("async semaphore")
+{
+    SECTION("try_acquire")
+    {
+        coro::AsyncSemaphore sem{1};
+
+        REQUIRE(sem.try_acquire());
+        REQUIRE_FALSE(sem.try_acquire());
+        sem.release();
+        REQUIRE(sem.try_acquire());
+    }
+
+    SECTION("limits concurrency")
+    {
+        constexpr int limit = 3;
+
+        helpers::ThreadPool pool{8};
+        coro::AsyncSemaphore sem{limit};
+        std::atomic<int> inside{0};
+        std::atomic<int> max_inside{0};
+
+        auto worker = [&]() -> coro::Task<> {
+            co_await pool.schedule();
+            for (int i = 0; i < 100; ++i)
+            {
+                co_await sem.acquire();
+                int now_inside = ++inside;
+                int expected = max_inside.load();
+                while (now_inside > expected && !max_inside.compare_exchange_weak(expected, now_inside))
+                { }
+                std::this_thread::yield();
+                --inside;
+                sem.release();
+            }
+        };
+
+        std::vector<coro::Task<>> tasks;
+        for (int i = 0; i < coroutines_count; ++i)
+            tasks.push_back(worker());
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+
+        REQUIRE(max_inside <= limit);
+        REQUIRE(sem.try_acquire()); // all permits are back
+    }
+
+    SECTION("release wakes waiters in FIFO order")
+    {
+        coro::AsyncSemaphore sem{0};
+        std::vector<int> order;
+
+        coro::AsyncScope scope;
+        for (int id = 0; id < 3; ++id)
+            scope.spawn([](coro::AsyncSemaphore& sem, std::vector<int>& order, int id) -> coro::Task<> {
+                co_await sem.acquire();
+                order.push_back(id);
+            }(sem, order, id));
+
+        sem.release(3);
+        coro::sync_wait(scope.join());
+
+        REQUIRE(order == std::vector{0, 1, 2});
+    }
+
+    SECTION("long hand-off chain does not nest resumptions")
+    {
+        constexpr int waiters_count = 100'000;
+        coro::AsyncSemaphore sem{0};
+        int counter = 0;
+
+        coro::AsyncScope scope;
+        for (int i = 0; i < waiters_count; ++i)
+            scope.spawn([](coro::AsyncSemaphore& sem, int& counter) -> coro::Task<> {
+                co_await sem.acquire();
+                ++counter;
+                sem.release();
+            }(sem, counter));
+
+        sem.release();
+        coro::sync_wait(scope.join());
+
+        REQUIRE(counter == waiters_count);
+        REQUIRE(sem.try_acquire());
+        REQUIRE_FALSE(sem.try_acquire());
+    }
+}
+
+TEST_CASE("async latch")
+{
+    SECTION("waiters are resumed when the count reaches zero")
+    {
+        coro::AsyncLatch latch{2};
+        int resumed = 0;
+
+        coro::AsyncScope scope;
+        for (int i = 0; i < 3; ++i)
+            scope.spawn([](coro::AsyncLatch& latch, int& resumed) -> coro::Task<> {
+                co_await latch.wait();
+                ++resumed;
+            }(latch, resumed));
+
+        latch.count_down();
+        REQUIRE(resumed == 0);
+        REQUIRE_FALSE(latch.try_wait());
+
+        latch.count_down();
+        REQUIRE(resumed == 3);
+
+        coro::sync_wait(scope.join());
+    }
+
+    SECTION("released latch does not suspend")
+    {
+        coro::AsyncLatch latch{1};
+        latch.count_down();
+
+        REQUIRE(latch.try_wait());
+        coro::sync_wait(latch.wait());
+    }
+}
+
+TEST_CASE("async mutex vs std::mutex - 64 contending coroutines", "[.][benchmark]")
+{
+    helpers::ThreadPool pool{std::max(2u, std::thread::hardware_concurrency())};
+
+    BENCHMARK("coro::AsyncMutex")
+    {
+        coro::AsyncMutex mtx;
+        return run_contended(pool, mtx, increment_with_async_mutex);
+    };
+
+    BENCHMARK("std::mutex")
+    {
+        std::mutex mtx;
+        return run_contended(pool, mtx, increment_with_std_mutex);
+    };
+}
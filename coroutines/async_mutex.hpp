@@ -0,0 +1,532 @@
+#ifndef ASYNC_MUTEX_HPP
+#define ASYNC_MUTEX_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+namespace coro
+{
+    // anything that can run a callable later - helpers::ThreadPool (submit) or coro::EventLoop (post)
+    template <typename TExecutor>
+    concept Executor = requires(TExecutor& executor, void (*job)()) { executor.submit(job); }
+        || requires(TExecutor& executor, void (*job)()) { executor.post(job); };
+
+    namespace detail
+    {
+        // intrusive node of a waiter list - lives in the frame of the suspended coroutine
+        struct AsyncWaiter
+        {
+            AsyncWaiter* next = nullptr;
+            std::coroutine_handle<> coro_hndl;
+            void* executor = nullptr;
+            void (*resume_on_executor)(void*, std::coroutine_handle<>) = nullptr;
+
+            template <Executor TExecutor>
+            void set_executor(TExecutor& designated) noexcept
+            {
+                executor = &designated;
+                resume_on_executor = [](void* executor, std::coroutine_handle<> coro_hndl) {
+                    auto& ex = *static_cast<TExecutor*>(executor);
+                    if constexpr (requires { ex.submit([coro_hndl] { coro_hndl.resume(); }); })
+                        ex.submit([coro_hndl] { coro_hndl.resume(); });
+                    else
+                        ex.post([coro_hndl] { coro_hndl.resume(); });
+                };
+            }
+
+            // inline on the releasing thread unless an executor was designated
+            void resume()
+            {
+                if (executor)
+                    resume_on_executor(executor, coro_hndl);
+                else
+                    coro_hndl.resume();
+            }
+        };
+
+        // resumes a list of waiters (linked by next) from a loop - a waiter resumed inline that hands off again
+        // (unlock, release) only appends to the list of the loop already running on this thread,
+        // so a chain of hand-offs through a long queue does not nest resume() calls
+        inline void resume_waiters(AsyncWaiter* waiters)
+        {
+            struct Trampoline
+            {
+                AsyncWaiter* head = nullptr;
+                AsyncWaiter* tail = nullptr;
+                bool running = false;
+            };
+            thread_local Trampoline trampoline;
+
+            while (waiters)
+            {
+                AsyncWaiter* waiter = std::exchange(waiters, waiters->next); // next is read before the frame may be gone
+                if (waiter->executor)
+                {
+                    waiter->resume(); // queued on the executor - no nesting
+                    continue;
+                }
+
+                waiter->next = nullptr;
+                (trampoline.tail ? trampoline.tail->next : trampoline.head) = waiter;
+                trampoline.tail = waiter;
+            }
+
+            if (trampoline.running)
+                return;
+
+            trampoline.running = true;
+            while (trampoline.head)
+            {
+                AsyncWaiter* waiter = std::exchange(trampoline.head, trampoline.head->next);
+                if (!trampoline.head)
+                    trampoline.tail = nullptr;
+                waiter->coro_hndl.resume();
+            }
+            trampoline.running = false;
+        }
+
+        // waiters are pushed on a lock-free stack - reversing it restores arrival order
+        inline AsyncWaiter* reverse(AsyncWaiter* stack) noexcept
+        {
+            AsyncWaiter* fifo = nullptr;
+            while (stack)
+            {
+                AsyncWaiter* next = stack->next;
+                stack->next = fifo;
+                fifo = stack;
+                stack = next;
+            }
+
+            return fifo;
+        }
+    } // namespace detail
+
+    class AsyncMutex;
+
+    // owns a locked AsyncMutex - unlocks it on destruction
+    class [[nodiscard]] AsyncMutexLock
+    {
+    public:
+        explicit AsyncMutexLock(AsyncMutex& mtx, std::adopt_lock_t) noexcept
+            : mtx_{&mtx}
+        {
+        }
+
+        AsyncMutexLock(const AsyncMutexLock&) = delete;
+        AsyncMutexLock& operator=(const AsyncMutexLock&) = delete;
+
+        AsyncMutexLock(AsyncMutexLock&& other) noexcept
+            : mtx_{std::exchange(other.mtx_, nullptr)}
+        {
+        }
+
+        AsyncMutexLock& operator=(AsyncMutexLock&& other) noexcept;
+
+        ~AsyncMutexLock();
+
+        void unlock();
+
+    private:
+        AsyncMutex* mtx_;
+    };
+
+    // mutex that suspends the awaiting coroutine instead of blocking its thread;
+    // uncontended lock is a single CAS, the lock is handed off to waiters in FIFO order
+    class AsyncMutex
+    {
+        static constexpr std::uintptr_t not_locked = 1;
+        static constexpr std::uintptr_t locked_no_waiters = 0;
+
+        class LockOperation : protected detail::AsyncWaiter
+        {
+        public:
+            explicit LockOperation(AsyncMutex& mtx) noexcept
+                : mtx_{mtx}
+            {
+            }
+
+            template <Executor TExecutor>
+            LockOperation(AsyncMutex& mtx, TExecutor& executor) noexcept
+                : mtx_{mtx}
+            {
+                set_executor(executor);
+            }
+
+            bool await_ready() noexcept
+            {
+                return mtx_.try_lock();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                coro_hndl = awaiting_coro;
+
+                std::uintptr_t state = mtx_.state_.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    if (state == not_locked)
+                    {
+                        if (mtx_.state_.compare_exchange_weak(state, locked_no_waiters, std::memory_order_acquire, std::memory_order_relaxed))
+                            return false; // unlocked in the meantime - no need to suspend
+                    }
+                    else
+                    {
+                        next = reinterpret_cast<detail::AsyncWaiter*>(state);
+                        if (mtx_.state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(static_cast<detail::AsyncWaiter*>(this)),
+                                std::memory_order_release, std::memory_order_relaxed))
+                            return true; // may be resumed by unlock() before returning
+                    }
+                }
+            }
+
+            void await_resume() const noexcept { }
+
+        protected:
+            AsyncMutex& mtx_;
+        };
+
+        class ScopedLockOperation : public LockOperation
+        {
+        public:
+            using LockOperation::LockOperation;
+
+            AsyncMutexLock await_resume() const noexcept
+            {
+                return AsyncMutexLock{mtx_, std::adopt_lock};
+            }
+        };
+
+    public:
+        AsyncMutex() noexcept = default;
+
+        AsyncMutex(const AsyncMutex&) = delete;
+        AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+        ~AsyncMutex()
+        {
+            assert(state_.load(std::memory_order_relaxed) == not_locked);
+        }
+
+        bool try_lock() noexcept
+        {
+            std::uintptr_t expected = not_locked;
+            return state_.compare_exchange_strong(expected, locked_no_waiters, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+
+        // co_await mtx.lock() - the mutex must be unlocked with unlock()
+        [[nodiscard]] LockOperation lock() noexcept
+        {
+            return LockOperation{*this};
+        }
+
+        // co_await mtx.scoped_lock() - returns AsyncMutexLock
+        [[nodiscard]] ScopedLockOperation scoped_lock() noexcept
+        {
+            return ScopedLockOperation{*this};
+        }
+
+        // a coroutine that had to wait is resumed on the designated executor instead of the unlocking thread
+        template <Executor TExecutor>
+        [[nodiscard]] ScopedLockOperation scoped_lock(TExecutor& executor) noexcept
+        {
+            return ScopedLockOperation{*this, executor};
+        }
+
+        void unlock()
+        {
+            assert(state_.load(std::memory_order_relaxed) != not_locked);
+
+            detail::AsyncWaiter* head = waiters_;
+            if (!head)
+            {
+                std::uintptr_t expected = locked_no_waiters;
+                if (state_.compare_exchange_strong(expected, not_locked, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+
+                // new waiters arrived - take all of them at once
+                head = detail::reverse(reinterpret_cast<detail::AsyncWaiter*>(state_.exchange(locked_no_waiters, std::memory_order_acquire)));
+            }
+
+            waiters_ = head->next;
+            head->next = nullptr;
+            detail::resume_waiters(head); // ownership is handed off - the mutex stays locked
+        }
+
+    private:
+        // not_locked, locked_no_waiters or a stack of waiters that arrived since the last unlock()
+        std::atomic<std::uintptr_t> state_{not_locked};
+        detail::AsyncWaiter* waiters_ = nullptr; // FIFO of waiters - touched only by the lock owner
+    };
+
+    inline AsyncMutexLock& AsyncMutexLock::operator=(AsyncMutexLock&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (mtx_)
+                mtx_->unlock();
+            mtx_ = std::exchange(other.mtx_, nullptr);
+        }
+
+        return *this;
+    }
+
+    inline AsyncMutexLock::~AsyncMutexLock()
+    {
+        if (mtx_)
+            mtx_->unlock();
+    }
+
+    inline void AsyncMutexLock::unlock()
+    {
+        std::exchange(mtx_, nullptr)->unlock();
+    }
+
+    // counting semaphore for coroutines; acquirers never block a thread and are served in FIFO order
+    // one atomic word holds either the free permits or the stack of waiters, so an acquirer decides
+    // to take a permit or to wait in a single CAS - a releaser never waits for a waiter to show up
+    class AsyncSemaphore
+    {
+        // (permits << 1) | 1 - odd; a waiter stack (aligned pointer) - even, then there are no free permits
+        static constexpr std::uintptr_t permits_flag = 1;
+        static_assert(alignof(detail::AsyncWaiter) > 1);
+
+        class AcquireOperation : detail::AsyncWaiter
+        {
+        public:
+            explicit AcquireOperation(AsyncSemaphore& sem) noexcept
+                : sem_{sem}
+            {
+            }
+
+            template <Executor TExecutor>
+            AcquireOperation(AsyncSemaphore& sem, TExecutor& executor) noexcept
+                : sem_{sem}
+            {
+                set_executor(executor);
+            }
+
+            bool await_ready() noexcept
+            {
+                return sem_.try_acquire();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                coro_hndl = awaiting_coro;
+
+                std::uintptr_t state = sem_.state_.load(std::memory_order_acquire);
+                while (true)
+                {
+                    if (state > permits_flag && (state & permits_flag))
+                    {
+                        if (sem_.state_.compare_exchange_weak(state, state - 2, std::memory_order_acquire, std::memory_order_acquire))
+                            return false; // released in the meantime
+                    }
+                    else
+                    {
+                        next = state == permits_flag ? nullptr : reinterpret_cast<detail::AsyncWaiter*>(state);
+                        if (sem_.state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(static_cast<detail::AsyncWaiter*>(this)),
+                                std::memory_order_release, std::memory_order_acquire))
+                            return true; // may be resumed by release() before returning
+                    }
+                }
+            }
+
+            void await_resume() const noexcept { }
+
+        private:
+            AsyncSemaphore& sem_;
+        };
+
+    public:
+        explicit AsyncSemaphore(std::ptrdiff_t initial_count) noexcept
+            : state_{(static_cast<std::uintptr_t>(std::max<std::ptrdiff_t>(initial_count, 0)) << 1) | permits_flag}
+        {
+        }
+
+        AsyncSemaphore(const AsyncSemaphore&) = delete;
+        AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+
+        bool try_acquire() noexcept
+        {
+            std::uintptr_t state = state_.load(std::memory_order_relaxed);
+            while (state > permits_flag && (state & permits_flag))
+            {
+                if (state_.compare_exchange_weak(state, state - 2, std::memory_order_acquire, std::memory_order_relaxed))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // co_await sem.acquire()
+        [[nodiscard]] AcquireOperation acquire() noexcept
+        {
+            return AcquireOperation{*this};
+        }
+
+        // a coroutine that had to wait is resumed on the designated executor instead of the releasing thread
+        template <Executor TExecutor>
+        [[nodiscard]] AcquireOperation acquire(TExecutor& executor) noexcept
+        {
+            return AcquireOperation{*this, executor};
+        }
+
+        // every released permit goes to the first waiter or, if there is none, back to the free permits;
+        // the first of concurrent releasers hands out the permits of all of them - the others return at once
+        void release(std::ptrdiff_t update = 1)
+        {
+            assert(update >= 0);
+
+            std::size_t permits = static_cast<std::size_t>(update);
+            if (permits == 0 || pending_permits_.fetch_add(permits, std::memory_order_acq_rel) != 0)
+                return;
+
+            detail::AsyncWaiter* woken = nullptr;
+            detail::AsyncWaiter* woken_tail = nullptr;
+            do
+            {
+                for (std::size_t i = 0; i < permits; ++i)
+                {
+                    if (detail::AsyncWaiter* waiter = pop_waiter_or_add_permit())
+                    {
+                        waiter->next = nullptr;
+                        (woken_tail ? woken_tail->next : woken) = waiter;
+                        woken_tail = waiter;
+                    }
+                }
+
+                permits = pending_permits_.fetch_sub(permits, std::memory_order_acq_rel) - permits;
+            } while (permits > 0);
+
+            detail::resume_waiters(woken); // user code runs after the permits are handed out
+        }
+
+    private:
+        std::atomic<std::uintptr_t> state_;
+        std::atomic<std::size_t> pending_permits_{0};
+        detail::AsyncWaiter* waiters_ = nullptr; // FIFO - touched only by the releaser handing out permits
+
+        detail::AsyncWaiter* pop_waiter_or_add_permit() noexcept
+        {
+            if (!waiters_)
+            {
+                std::uintptr_t state = state_.load(std::memory_order_acquire);
+                while (true)
+                {
+                    if (state & permits_flag)
+                    {
+                        if (state_.compare_exchange_weak(state, state + 2, std::memory_order_release, std::memory_order_acquire))
+                            return nullptr;
+                    }
+                    else if (state_.compare_exchange_weak(state, permits_flag, std::memory_order_acquire, std::memory_order_acquire))
+                    {
+                        waiters_ = detail::reverse(reinterpret_cast<detail::AsyncWaiter*>(state));
+                        break;
+                    }
+                }
+            }
+
+            return std::exchange(waiters_, waiters_->next);
+        }
+    };
+
+    // single-use barrier for coroutines - waiters are resumed by the count_down() that reaches zero
+    class AsyncLatch
+    {
+        static constexpr std::uintptr_t released = 1;
+
+        class WaitOperation : detail::AsyncWaiter
+        {
+        public:
+            explicit WaitOperation(AsyncLatch& latch) noexcept
+                : latch_{latch}
+            {
+            }
+
+            template <Executor TExecutor>
+            WaitOperation(AsyncLatch& latch, TExecutor& executor) noexcept
+                : latch_{latch}
+            {
+                set_executor(executor);
+            }
+
+            bool await_ready() const noexcept
+            {
+                return latch_.try_wait();
+            }
+
+            bool await_suspend(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                coro_hndl = awaiting_coro;
+
+                std::uintptr_t state = latch_.state_.load(std::memory_order_acquire);
+                do
+                {
+                    if (state == released)
+                        return false;
+
+                    next = reinterpret_cast<detail::AsyncWaiter*>(state);
+                } while (!latch_.state_.compare_exchange_weak(state, reinterpret_cast<std::uintptr_t>(static_cast<detail::AsyncWaiter*>(this)),
+                    std::memory_order_acq_rel, std::memory_order_acquire));
+
+                return true;
+            }
+
+            void await_resume() const noexcept { }
+
+        private:
+            AsyncLatch& latch_;
+        };
+
+    public:
+        explicit AsyncLatch(std::ptrdiff_t expected) noexcept
+            : count_{expected}
+        {
+            if (expected <= 0)
+                state_.store(released, std::memory_order_relaxed);
+        }
+
+        AsyncLatch(const AsyncLatch&) = delete;
+        AsyncLatch& operator=(const AsyncLatch&) = delete;
+
+        void count_down(std::ptrdiff_t update = 1)
+        {
+            if (count_.fetch_sub(update, std::memory_order_acq_rel) != update)
+                return;
+
+            detail::AsyncWaiter* waiter = detail::reverse(reinterpret_cast<detail::AsyncWaiter*>(state_.exchange(released, std::memory_order_acq_rel)));
+            while (waiter)
+                std::exchange(waiter, waiter->next)->resume(); // next is read before the frame may be gone
+        }
+
+        bool try_wait() const noexcept
+        {
+            return state_.load(std::memory_order_acquire) == released;
+        }
+
+        // co_await latch.wait()
+        [[nodiscard]] WaitOperation wait() noexcept
+        {
+            return WaitOperation{*this};
+        }
+
+        template <Executor TExecutor>
+        [[nodiscard]] WaitOperation wait(TExecutor& executor) noexcept
+        {
+            return WaitOperation{*this, executor};
+        }
+
+    private:
+        std::atomic<std::ptrdiff_t> count_;
+        std::atomic<std::uintptr_t> state_{0}; // stack of waiters or released
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,72 @@
+#include "async_scope.hpp"
+#include "task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <vector>
+
+namespace
+{
+    coro::Task<> increment_on(helpers::ThreadPool& pool, std::atomic<int>& counter)
+    {
+        co_await pool.schedule();
+        ++counter;
+    }
+
+    coro::Task<int> spawn_and_join(helpers::ThreadPool& pool, std::atomic<int>& counter)
+    {
+        coro::AsyncScope scope;
+
+        for (int i = 0; i < 10; ++i)
+            scope.spawn(increment_on(pool, counter));
+
+        co_await scope.join();
+
+        co_return counter.load();
+    }
+} // namespace
+
+TEST_CASE("async scope")
+{
+    helpers::ThreadPool pool{4};
+    std::atomic<int> counter{};
+
+    SECTION("blocking join waits for all spawned coroutines")
+    {
+        coro::AsyncScope scope;
+
+        for (int i = 0; i < 1'000; ++i)
+            scope.spawn(increment_on(pool, counter));
+
+        coro::sync_wait(scope.join());
+
+        REQUIRE(counter == 1'000);
+        REQUIRE(scope.in_flight() == 0);
+    }
+
+    SECTION("co_await join")
+    {
+        REQUIRE(coro::sync_wait(spawn_and_join(pool, counter)) == 10);
+    }
+
+    SECTION("join of an empty scope completes immediately")
+    {
+        coro::AsyncScope scope;
+
+        coro::sync_wait(scope.join());
+
+        REQUIRE(scope.in_flight() == 0);
+    }
+
+    SECTION("destructor joins outstanding work")
+    {
+        {
+            coro::AsyncScope scope;
+            scope.spawn(increment_on(pool, counter));
+        }
+
+        REQUIRE(counter == 1);
+    }
+}
@@ -0,0 +1,151 @@
+#ifndef ASYNC_SCOPE_HPP
+#define ASYNC_SCOPE_HPP
+
+#include "task.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+namespace coro
+{
+    // structured owner of detached coroutines - every spawned coroutine is counted until it completes
+    class AsyncScope
+    {
+        struct SpawnedTask
+        {
+            struct promise_type
+            {
+                AsyncScope& scope;
+
+                template <typename TAwaitable>
+                promise_type(AsyncScope& scope, TAwaitable&) noexcept
+                    : scope{scope}
+                {
+                }
+
+                SpawnedTask get_return_object() noexcept
+                {
+                    return {};
+                }
+
+                std::suspend_never initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                auto final_suspend() const noexcept
+                {
+                    struct Releaser
+                    {
+                        bool await_ready() const noexcept { return false; }
+
+                        void await_suspend(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                        {
+                            AsyncScope& scope = coro_hndl.promise().scope;
+                            coro_hndl.destroy(); // frame is gone before join() may observe completion
+                            scope.on_work_finished();
+                        }
+
+                        void await_resume() const noexcept { }
+                    };
+
+                    return Releaser{};
+                }
+
+                void return_void() noexcept { }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+        };
+
+        struct JoinAwaiter
+        {
+            AsyncScope& scope;
+
+            bool await_ready() const noexcept
+            {
+                return scope.count_.load(std::memory_order_acquire) == 0;
+            }
+
+            bool await_suspend(std::coroutine_handle<> joining_coro) noexcept
+            {
+                scope.joining_coro_ = joining_coro;
+                return scope.count_.fetch_sub(scope_reference, std::memory_order_acq_rel) > scope_reference; // drops the scope's own reference
+            }
+
+            void await_resume() const noexcept { }
+        };
+
+        template <typename TAwaitable>
+        static SpawnedTask run_in_scope(AsyncScope&, TAwaitable awaitable)
+        {
+            co_await std::move(awaitable);
+        }
+
+    public:
+        AsyncScope() = default;
+        AsyncScope(const AsyncScope&) = delete;
+        AsyncScope& operator=(const AsyncScope&) = delete;
+
+        // shutdown is deterministic - a scope that was not joined waits for its work here
+        ~AsyncScope()
+        {
+            if (!joined())
+                sync_wait(join());
+        }
+
+        // starts the awaitable eagerly on the current thread; it is tracked until it completes
+        template <typename TAwaitable>
+        void spawn(TAwaitable&& awaitable)
+        {
+            on_work_started();
+            run_in_scope(*this, std::forward<TAwaitable>(awaitable));
+        }
+
+        void on_work_started() noexcept
+        {
+            assert(!joined());
+            count_.fetch_add(work_unit, std::memory_order_relaxed);
+        }
+
+        void on_work_finished() noexcept
+        {
+            if (count_.fetch_sub(work_unit, std::memory_order_acq_rel) == work_unit)
+                joining_coro_.resume();
+        }
+
+        std::size_t in_flight() const noexcept
+        {
+            return count_.load(std::memory_order_acquire) / work_unit;
+        }
+
+        // co_await scope.join() - or coro::sync_wait(scope.join()) to block
+        [[nodiscard]] JoinAwaiter join() noexcept
+        {
+            return JoinAwaiter{*this};
+        }
+
+    private:
+        static constexpr std::size_t scope_reference = 1;
+        static constexpr std::size_t work_unit = 2;
+
+        // bit 0 - reference held by the scope until join(); the rest counts in-flight work,
+        // so the joined state and the count are read together from other threads
+        std::atomic<std::size_t> count_{scope_reference};
+        std::coroutine_handle<> joining_coro_;
+
+        bool joined() const noexcept
+        {
+            return (count_.load(std::memory_order_acquire) & scope_reference) == 0;
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,149 @@
+#include "async_scope.hpp"
+#include "batcher.hpp"
+#include "task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    void doubled(std::span<int> requests, std::vector<int>& responses)
+    {
+        for (int request : requests)
+            responses.push_back(request * 2);
+    }
+
+    coro::Task<> lookup(coro::Batcher<int, int>& batcher, int request, int& response)
+    {
+        response = co_await batcher.submit(request);
+    }
+
+    coro::Task<> timed_lookup(coro::Batcher<int, int>& batcher, int request, std::chrono::nanoseconds& latency)
+    {
+        auto start = std::chrono::steady_clock::now();
+        co_await batcher.submit(request);
+        latency = std::chrono::steady_clock::now() - start;
+    }
+} // namespace
+
+TEST_CASE("batcher")
+{
+    std::mutex mtx_batch_sizes;
+    std::vector<size_t> batch_sizes;
+
+    auto recording_handler = [&](std::span<int> requests, std::vector<int>& responses) {
+        std::lock_guard lk{mtx_batch_sizes};
+        batch_sizes.push_back(requests.size());
+        doubled(requests, responses);
+    };
+
+    SECTION("batch is flushed when it reaches max size")
+    {
+        coro::Batcher<int, int> batcher{recording_handler, 4, 1h};
+        std::vector<int> responses(8);
+
+        coro::AsyncScope scope;
+        for (int i = 0; i < 8; ++i)
+            scope.spawn(lookup(batcher, i, responses[i]));
+        coro::sync_wait(scope.join());
+
+        REQUIRE(responses == std::vector{0, 2, 4, 6, 8, 10, 12, 14});
+        REQUIRE(batch_sizes == std::vector<size_t>{4, 4});
+        REQUIRE(batcher.stats().batches == 2);
+        REQUIRE(batcher.stats().requests == 8);
+    }
+
+    SECTION("incomplete batch is flushed after linger time")
+    {
+        coro::Batcher<int, int> batcher{recording_handler, 100, 5ms};
+        std::vector<int> responses(3);
+
+        coro::AsyncScope scope;
+        for (int i = 0; i < 3; ++i)
+            scope.spawn(lookup(batcher, i + 1, responses[i]));
+        coro::sync_wait(scope.join());
+
+        REQUIRE(responses == std::vector{2, 4, 6});
+        REQUIRE(batch_sizes == std::vector<size_t>{3});
+    }
+
+    SECTION("exception from the handler is rethrown in every waiter")
+    {
+        coro::Batcher<int, int> batcher{[](std::span<int>, std::vector<int>&) { throw std::runtime_error{"backend down"}; }, 2, 1ms};
+
+        REQUIRE_THROWS_AS(coro::sync_wait(batcher.submit(1)), std::runtime_error);
+    }
+
+    SECTION("handler must return one response per request")
+    {
+        coro::Batcher<int, int> batcher{[](std::span<int>, std::vector<int>&) { }, 1, 1ms};
+
+        REQUIRE_THROWS_AS(coro::sync_wait(batcher.submit(1)), std::logic_error);
+    }
+
+    SECTION("response buffer is reused across batches")
+    {
+        std::vector<std::size_t> capacities;
+        bool all_empty = true;
+        coro::Batcher<int, int> batcher{[&](std::span<int> requests, std::vector<int>& responses) {
+                                            all_empty = all_empty && responses.empty();
+                                            capacities.push_back(responses.capacity());
+                                            doubled(requests, responses);
+                                        },
+            4, 1h};
+
+        for (int round = 0; round < 2; ++round)
+        {
+            std::vector<int> responses(4);
+
+            coro::AsyncScope scope;
+            for (int i = 0; i < 4; ++i)
+                scope.spawn(lookup(batcher, i, responses[i]));
+            coro::sync_wait(scope.join());
+
+            REQUIRE(responses == std::vector{0, 2, 4, 6});
+        }
+
+        REQUIRE(all_empty);
+        REQUIRE(capacities.size() == 2);
+        REQUIRE(capacities[1] >= 4);
+    }
+}
+
+TEST_CASE("batcher - latency vs batch size & linger", "[.][benchmark]")
+{
+    constexpr int requests_count = 10'000;
+
+    for (auto [max_batch_size, linger] : {std::pair{1uz, 0us}, std::pair{16uz, 50us}, std::pair{256uz, 500us}})
+    {
+        coro::Batcher<int, int> batcher{doubled, max_batch_size, linger};
+        std::vector<std::chrono::nanoseconds> latencies(requests_count);
+
+        auto start = std::chrono::steady_clock::now();
+        coro::AsyncScope scope;
+        for (int i = 0; i < requests_count; ++i)
+            scope.spawn(timed_lookup(batcher, i, latencies[i]));
+        coro::sync_wait(scope.join());
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        std::ranges::sort(latencies);
+        auto percentile = [&latencies](double p) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(latencies[static_cast<size_t>(p * (latencies.size() - 1))]).count();
+        };
+
+        std::cout << "batch size = " << max_batch_size << ", linger = " << linger.count() << "us: "
+                  << "p50 = " << percentile(0.5) << "us, "
+                  << "p99 = " << percentile(0.99) << "us, "
+                  << "throughput = " << requests_count * 1'000'000'000LL / std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() << " req/s, "
+                  << "batches = " << batcher.stats().batches << "\n";
+    }
+}
@@ -0,0 +1,215 @@
+#ifndef BATCHER_HPP
+#define BATCHER_HPP
+
+#include "task.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace coro
+{
+    // gathers requests submitted by coroutines and serves them with one call of the batch handler;
+    // a batch is flushed when it reaches max_batch_size or when its first request has waited for linger
+    template <typename Req, typename Resp>
+    class Batcher
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        // appends the i-th response for the i-th request to an empty buffer that is reused for every batch
+        using Handler = std::function<void(std::span<Req>, std::vector<Resp>&)>;
+
+        struct Stats
+        {
+            std::uint64_t batches = 0;
+            std::uint64_t requests = 0;
+            std::size_t max_batch_size = 0;
+        };
+
+    private:
+        class SubmitAwaiter
+        {
+        public:
+            SubmitAwaiter(Batcher& batcher, Req request)
+                : batcher_{batcher}
+                , request_{std::move(request)}
+            {
+            }
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> coro_hndl)
+            {
+                coro_hndl_ = coro_hndl;
+                batcher_.enqueue(*this); // may be resumed on the batcher thread before returning
+            }
+
+            Resp await_resume()
+            {
+                return std::move(response_).get();
+            }
+
+        private:
+            friend class Batcher;
+
+            Batcher& batcher_;
+            Req request_;
+            std::coroutine_handle<> coro_hndl_;
+            detail::ResultStorage<Resp> response_;
+        };
+
+    public:
+        Batcher(Handler handler, std::size_t max_batch_size, Clock::duration linger)
+            : handler_{std::move(handler)}
+            , max_batch_size_{std::max<std::size_t>(1, max_batch_size)}
+            , linger_{linger}
+            , thread_{[this](std::stop_token stop_tkn) { run(stop_tkn); }}
+        {
+        }
+
+        Batcher(const Batcher&) = delete;
+        Batcher& operator=(const Batcher&) = delete;
+
+        // pending requests are served before the batcher thread exits
+        ~Batcher()
+        {
+            thread_.request_stop();
+            thread_.join();
+        }
+
+        // co_await batcher.submit(req) - resumes with the response on the batcher thread;
+        // an exception thrown by the handler is rethrown in every coroutine of the batch
+        [[nodiscard]] SubmitAwaiter submit(Req request)
+        {
+            return SubmitAwaiter{*this, std::move(request)};
+        }
+
+        Stats stats() const
+        {
+            std::lock_guard lk{mtx_pending_};
+            return stats_;
+        }
+
+    private:
+        Handler handler_;
+        const std::size_t max_batch_size_;
+        const Clock::duration linger_;
+
+        mutable std::mutex mtx_pending_;
+        std::condition_variable_any cv_pending_;
+        std::vector<Req> pending_requests_; // contiguous - passed to the handler as a span
+        std::vector<SubmitAwaiter*> pending_waiters_;
+        Clock::time_point batch_deadline_;
+        Stats stats_;
+        std::jthread thread_;
+
+        void enqueue(SubmitAwaiter& awaiter)
+        {
+            bool should_notify = false;
+            {
+                std::lock_guard lk{mtx_pending_};
+                if (pending_waiters_.empty())
+                    batch_deadline_ = Clock::now() + linger_;
+
+                pending_requests_.push_back(std::move(awaiter.request_));
+                pending_waiters_.push_back(&awaiter);
+
+                // the batcher thread waits either for the first request or for a full batch
+                should_notify = pending_waiters_.size() == 1 || pending_waiters_.size() >= max_batch_size_;
+            }
+
+            if (should_notify)
+                cv_pending_.notify_one();
+        }
+
+        void run(std::stop_token stop_tkn)
+        {
+            // buffers are swapped with the pending ones or reused - no allocation in the steady state
+            std::vector<Req> requests;
+            std::vector<SubmitAwaiter*> waiters;
+            std::vector<Resp> responses;
+
+            std::unique_lock lk{mtx_pending_};
+            while (true)
+            {
+                if (pending_waiters_.empty())
+                {
+                    if (!cv_pending_.wait(lk, stop_tkn, [this] { return !pending_waiters_.empty(); }))
+                        return; // stopped with nothing pending
+                }
+
+                const auto deadline = batch_deadline_;
+                cv_pending_.wait_until(lk, stop_tkn, deadline, [this] { return pending_waiters_.size() >= max_batch_size_; });
+
+                const std::size_t batch_size = std::min(pending_waiters_.size(), max_batch_size_);
+                take_batch(batch_size, requests, waiters);
+                lk.unlock();
+
+                serve(requests, waiters, responses);
+                requests.clear();
+                waiters.clear();
+                responses.clear();
+
+                lk.lock();
+            }
+        }
+
+        void take_batch(std::size_t batch_size, std::vector<Req>& requests, std::vector<SubmitAwaiter*>& waiters)
+        {
+            if (batch_size == pending_waiters_.size())
+            {
+                requests.swap(pending_requests_);
+                waiters.swap(pending_waiters_);
+            }
+            else // submissions arrived faster than the batcher thread could wake up
+            {
+                requests.assign(std::make_move_iterator(pending_requests_.begin()), std::make_move_iterator(pending_requests_.begin() + batch_size));
+                waiters.assign(pending_waiters_.begin(), pending_waiters_.begin() + batch_size);
+                pending_requests_.erase(pending_requests_.begin(), pending_requests_.begin() + batch_size);
+                pending_waiters_.erase(pending_waiters_.begin(), pending_waiters_.begin() + batch_size);
+            }
+
+            if (!pending_waiters_.empty())
+                batch_deadline_ = Clock::now(); // the rest has already waited - flush it in the next round
+
+            ++stats_.batches;
+            stats_.requests += batch_size;
+            stats_.max_batch_size = std::max(stats_.max_batch_size, batch_size);
+        }
+
+        void serve(std::vector<Req>& requests, const std::vector<SubmitAwaiter*>& waiters, std::vector<Resp>& responses)
+        {
+            try
+            {
+                handler_(std::span<Req>{requests}, responses);
+                if (responses.size() != waiters.size())
+                    throw std::logic_error{"Batcher: the handler must return one response per request"};
+
+                for (std::size_t i = 0; i < waiters.size(); ++i)
+                    waiters[i]->response_.set_value(std::move(responses[i]));
+            }
+            catch (...)
+            {
+                for (SubmitAwaiter* waiter : waiters)
+                    waiter->response_.set_exception(std::current_exception());
+            }
+
+            for (SubmitAwaiter* waiter : waiters)
+                waiter->coro_hndl_.resume();
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,302 @@
+#include "async_generator.hpp"
+#include "event_loop.hpp"
+#include "task.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <future>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+// Cost of the coroutine machinery compared with plain calls and threads.
+// Run with: bench-coroutines --reporter JSON --out bench-coroutines.json
+//
+// "halo" variants keep the coroutine handle local to the caller, so a compiler that implements
+// heap allocation elision (clang at -O2) can place the frame in the caller's frame;
+// "escaping" variants pass the handle (or the task owning it) through an opaque function,
+// which always forces a heap allocation - every benchmark with a coroutine frame has both.
+
+namespace
+{
+    [[gnu::noinline]] int plain_call(int x)
+    {
+        return x + 1;
+    }
+
+    int plain_recursion(int depth)
+    {
+        return depth == 0 ? 0 : plain_recursion(depth - 1) + 1;
+    }
+
+    coro::Task<int> task_value(int x)
+    {
+        co_return x + 1;
+    }
+
+    coro::Task<int> task_recursion(int depth)
+    {
+        if (depth == 0)
+            co_return 0;
+
+        co_return co_await task_recursion(depth - 1) + 1;
+    }
+
+    coro::Task<int> await_local(int x)
+    {
+        co_return co_await task_value(x); // the awaited frame never outlives the caller
+    }
+
+    std::atomic<const void*> escaped_frame;
+
+    [[gnu::noinline]] void escape(std::coroutine_handle<> coro_hndl)
+    {
+        escaped_frame.store(coro_hndl.address(), std::memory_order_relaxed);
+    }
+
+    // the owner of a frame (task, generator) seen by an opaque function - its frame can no longer be elided
+    [[gnu::noinline]] void escape(const void* owner)
+    {
+        escaped_frame.store(owner, std::memory_order_relaxed);
+    }
+
+    coro::Task<int> await_escaping(int x)
+    {
+        auto task = task_value(x);
+        escape(&task);
+        co_return co_await std::move(task);
+    }
+
+    coro::Task<int> task_recursion_escaping(int depth)
+    {
+        if (depth == 0)
+            co_return 0;
+
+        auto child = task_recursion_escaping(depth - 1);
+        escape(&child);
+        co_return co_await std::move(child) + 1;
+    }
+
+    template <typename T>
+    T sync_wait_escaping(coro::Task<T> task)
+    {
+        escape(&task);
+        return coro::sync_wait(std::move(task));
+    }
+
+    // minimal coroutine resumed by hand - isolates the resume/suspend cost from any task bookkeeping
+    struct Resumable
+    {
+        struct promise_type
+        {
+            Resumable get_return_object() noexcept { return Resumable{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_always final_suspend() const noexcept { return {}; }
+            void return_void() noexcept { }
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> coro_hndl;
+
+        explicit Resumable(std::coroutine_handle<promise_type> coro_hndl) noexcept
+            : coro_hndl{coro_hndl}
+        {
+        }
+
+        Resumable(const Resumable&) = delete;
+        Resumable& operator=(const Resumable&) = delete;
+
+        ~Resumable()
+        {
+            coro_hndl.destroy();
+        }
+    };
+
+    Resumable counting_loop(int& counter)
+    {
+        while (true)
+        {
+            ++counter;
+            co_await std::suspend_always{};
+        }
+    }
+
+    coro::AsyncGenerator<int> iota(int count)
+    {
+        for (int i = 0; i < count; ++i)
+            co_yield std::move(i);
+    }
+
+    coro::Task<long> sum_generated(int count, bool escaping)
+    {
+        auto gen = iota(count);
+        if (escaping)
+            escape(&gen);
+
+        long sum = 0;
+        while (int* value = co_await gen.next())
+            sum += *value;
+
+        co_return sum;
+    }
+
+    template <typename TScheduler>
+    coro::Task<std::thread::id> thread_id_on(TScheduler& scheduler)
+    {
+        co_await scheduler.schedule();
+        co_return std::this_thread::get_id();
+    }
+} // namespace
+
+TEST_CASE("bench - frame creation & destruction", "[benchmark]")
+{
+    BENCHMARK("plain call")
+    {
+        return plain_call(42);
+    };
+
+    BENCHMARK("coroutine - halo")
+    {
+        int counter = 0;
+        Resumable resumable = counting_loop(counter); // created, resumed and destroyed in the same scope
+        resumable.coro_hndl.resume();
+        return counter;
+    };
+
+    BENCHMARK("coroutine - escaping")
+    {
+        int counter = 0;
+        Resumable resumable = counting_loop(counter);
+        escape(resumable.coro_hndl);
+        resumable.coro_hndl.resume();
+        return counter;
+    };
+
+    BENCHMARK("task - created & destroyed without running")
+    {
+        return task_value(42).is_ready();
+    };
+}
+
+TEST_CASE("bench - resume/suspend round-trip", "[benchmark]")
+{
+    int counter = 0;
+    Resumable resumable = counting_loop(counter);
+
+    BENCHMARK("plain call through a function pointer")
+    {
+        int (*volatile fn)(int) = &plain_call;
+        return fn(counter);
+    };
+
+    BENCHMARK("resume - suspend")
+    {
+        resumable.coro_hndl.resume();
+        return counter;
+    };
+
+    BENCHMARK("sync_wait(task) - halo")
+    {
+        return coro::sync_wait(await_local(42));
+    };
+
+    BENCHMARK("sync_wait(task) - escaping")
+    {
+        return coro::sync_wait(await_escaping(42));
+    };
+}
+
+TEST_CASE("bench - symmetric transfer depth", "[benchmark]")
+{
+    for (int depth : {1, 16, 256})
+    {
+        BENCHMARK("plain recursion - depth " + std::to_string(depth))
+        {
+            return plain_recursion(depth);
+        };
+
+        BENCHMARK("task recursion - halo - depth " + std::to_string(depth))
+        {
+            return coro::sync_wait(task_recursion(depth));
+        };
+
+        BENCHMARK("task recursion - escaping - depth " + std::to_string(depth))
+        {
+            return coro::sync_wait(task_recursion_escaping(depth));
+        };
+    }
+}
+
+TEST_CASE("bench - generator per element", "[benchmark]")
+{
+    constexpr int count = 10'000;
+
+    BENCHMARK("plain loop - 10'000 elements")
+    {
+        long sum = 0;
+        for (int i = 0; i < count; ++i)
+            sum += i;
+        return sum;
+    };
+
+    BENCHMARK("async generator - halo - 10'000 elements")
+    {
+        return coro::sync_wait(sum_generated(count, false));
+    };
+
+    BENCHMARK("async generator - escaping - 10'000 elements")
+    {
+        return coro::sync_wait(sum_generated(count, true));
+    };
+}
+
+TEST_CASE("bench - cross-thread handoff", "[benchmark]")
+{
+    helpers::ThreadPool pool{1};
+
+    coro::EventLoop loop;
+    std::jthread loop_thread{[&loop](std::stop_token stop_tkn) { loop.run(stop_tkn); }};
+
+    BENCHMARK("thread pool - co_await schedule() - halo")
+    {
+        return coro::sync_wait(thread_id_on(pool));
+    };
+
+    BENCHMARK("thread pool - co_await schedule() - escaping")
+    {
+        return sync_wait_escaping(thread_id_on(pool));
+    };
+
+    BENCHMARK("event loop - co_await schedule() - halo")
+    {
+        return coro::sync_wait(thread_id_on(loop));
+    };
+
+    BENCHMARK("event loop - co_await schedule() - escaping")
+    {
+        return sync_wait_escaping(thread_id_on(loop));
+    };
+
+    BENCHMARK("thread pool - submit & wait on std::promise")
+    {
+        std::promise<std::thread::id> promise;
+        pool.submit([&promise] { promise.set_value(std::this_thread::get_id()); });
+        return promise.get_future().get();
+    };
+
+    BENCHMARK("std::async")
+    {
+        return std::async(std::launch::async, [] { return std::this_thread::get_id(); }).get();
+    };
+
+    BENCHMARK("std::thread - start & join")
+    {
+        std::thread::id id;
+        std::thread{[&id] { id = std::this_thread::get_id(); }}.join();
+        return id;
+    };
+}
@@ -0,0 +1,124 @@
+#include "task.hpp"
+#include "timer.hpp"
+#include "when_all.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <chrono>
+#include <latch>
+#include <stop_token>
+
+using namespace std::literals;
+
+namespace
+{
+    coro::Task<bool> sleep(coro::Timer& timer, std::chrono::milliseconds duration)
+    {
+        std::stop_token stop_tkn = co_await coro::get_stop_token();
+        co_return co_await timer.sleep_for(duration, stop_tkn);
+    }
+
+    coro::Task<bool> sleep_twice(coro::Timer& timer, std::chrono::milliseconds duration)
+    {
+        // token of the outer task is propagated to the awaited one
+        bool first = co_await sleep(timer, duration);
+        bool second = co_await sleep(timer, duration);
+
+        co_return first && second;
+    }
+
+    coro::Task<int> value_after(coro::Timer& timer, int value, std::chrono::milliseconds duration)
+    {
+        std::stop_token stop_tkn = co_await coro::get_stop_token();
+        if (!co_await timer.sleep_for(duration, stop_tkn))
+            co_return -1;
+
+        co_return value;
+    }
+
+    template <typename TDuration>
+    auto elapsed_since(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<TDuration>(std::chrono::steady_clock::now() - start);
+    }
+} // namespace
+
+TEST_CASE("cancellation - timer")
+{
+    coro::Timer timer;
+
+    SECTION("sleep completes")
+    {
+        REQUIRE(coro::sync_wait(sleep(timer, 1ms)) == true);
+    }
+
+    SECTION("stop requested before sleep")
+    {
+        std::stop_source stop_src;
+        stop_src.request_stop();
+
+        auto task = sleep(timer, 10s);
+        task.set_stop_token(stop_src.get_token());
+
+        REQUIRE(coro::sync_wait(std::move(task)) == false);
+    }
+
+    SECTION("stop requested during sleep - the timer entry is released")
+    {
+        std::stop_source stop_src;
+
+        auto task = sleep_twice(timer, 10s);
+        task.set_stop_token(stop_src.get_token());
+
+        std::jthread canceller{[&] {
+            while (timer.pending() == 0)
+                std::this_thread::yield();
+            stop_src.request_stop();
+        }};
+
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(coro::sync_wait(std::move(task)) == false);
+        REQUIRE(elapsed_since<std::chrono::seconds>(start) < 5s);
+        REQUIRE(timer.pending() == 0);
+    }
+}
+
+TEST_CASE("cancellation - thread pool schedule")
+{
+    helpers::ThreadPool pool{1};
+    std::latch worker_released{1};
+
+    pool.submit([&] { worker_released.wait(); }); // the only worker is busy
+
+    std::stop_source stop_src;
+
+    auto scheduled = [](helpers::ThreadPool& pool) -> coro::Task<bool> {
+        std::stop_token stop_tkn = co_await coro::get_stop_token();
+        co_return co_await pool.schedule(stop_tkn);
+    }(pool);
+    scheduled.set_stop_token(stop_src.get_token());
+
+    std::jthread canceller{[&] {
+        std::this_thread::sleep_for(10ms);
+        stop_src.request_stop();
+    }};
+
+    REQUIRE(coro::sync_wait(std::move(scheduled)) == false);
+
+    worker_released.count_down();
+}
+
+TEST_CASE("cancellation - when_any stops the losers")
+{
+    coro::Timer timer;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto [index, value] = coro::sync_wait(coro::when_any(value_after(timer, 1, 10s), value_after(timer, 2, 1ms)));
+
+    REQUIRE(index == 1);
+    REQUIRE(value == 2);
+    REQUIRE(elapsed_since<std::chrono::seconds>(start) < 5s);
+    REQUIRE(timer.pending() == 0);
+}
@@ -0,0 +1,103 @@
+#include "coro_trace.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+    auto records_of(const void* frame)
+    {
+        auto records = coro::trace::Tracer::instance().snapshot();
+        std::erase_if(records, [frame](const auto& r) { return r.frame_id != reinterpret_cast<std::uintptr_t>(frame); });
+        return records;
+    }
+} // namespace
+
+TEST_CASE("coroutine tracer")
+{
+    auto& tracer = coro::trace::Tracer::instance();
+    tracer.clear(); // records of earlier sections may carry the same stack addresses as frame ids
+
+    SECTION("records events per thread")
+    {
+        int frame{};
+
+        tracer.record(&frame, coro::trace::Event::initial_suspend);
+        std::jthread{[&] {
+            tracer.record(&frame, coro::trace::Event::resume);
+            tracer.record(&frame, coro::trace::Event::suspend);
+        }}.join();
+        tracer.record(&frame, coro::trace::Event::destroy);
+
+        auto records = records_of(&frame);
+        std::ranges::sort(records, {}, &coro::trace::Record::tsc);
+
+        REQUIRE(records.size() == 4);
+        REQUIRE(records[0].event == coro::trace::Event::initial_suspend);
+        REQUIRE(records[1].event == coro::trace::Event::resume);
+        REQUIRE(records[1].thread_id == records[2].thread_id);
+        REQUIRE(records[0].thread_id != records[1].thread_id);
+        REQUIRE(records[3].thread_id == records[0].thread_id);
+    }
+
+    SECTION("ring buffer keeps the most recent events")
+    {
+        int frame{};
+
+        std::jthread{[&] {
+            for (size_t i = 0; i < 2 * coro::trace::ThreadBuffer::capacity; ++i)
+                tracer.record(&frame, coro::trace::Event::resume);
+        }}.join();
+
+        REQUIRE(records_of(&frame).size() == coro::trace::ThreadBuffer::capacity);
+    }
+
+    SECTION("buffers of exited threads are reused")
+    {
+        int frame{};
+
+        std::jthread{[&] { tracer.record(&frame, coro::trace::Event::resume); }}.join();
+        const std::size_t buffer_count = tracer.buffer_count();
+
+        for (int i = 0; i < 8; ++i)
+            std::jthread{[&] { tracer.record(&frame, coro::trace::Event::resume); }}.join();
+
+        REQUIRE(tracer.buffer_count() == buffer_count);
+    }
+
+    SECTION("snapshot while another thread keeps recording")
+    {
+        int frame{};
+        std::atomic<bool> done{false};
+
+        std::jthread recorder{[&] {
+            while (!done)
+                tracer.record(&frame, coro::trace::Event::resume);
+        }};
+
+        bool all_complete = true;
+        for (int i = 0; i < 20; ++i)
+            all_complete = all_complete && std::ranges::all_of(records_of(&frame), [](const auto& r) { return r.event == coro::trace::Event::resume; });
+        done = true;
+
+        REQUIRE(all_complete);
+    }
+
+    SECTION("export to chrome trace json")
+    {
+        int frame{};
+        tracer.record(&frame, coro::trace::Event::final_suspend);
+
+        std::ostringstream out;
+        tracer.export_chrome_trace(out);
+
+        const std::string json = out.str();
+        REQUIRE(json.starts_with("{\"traceEvents\":["));
+        REQUIRE(json.find("\"name\":\"final_suspend\"") != std::string::npos);
+    }
+}
@@ -0,0 +1,263 @@
+#ifndef CORO_TRACE_HPP
+#define CORO_TRACE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+namespace coro::trace
+{
+    enum class Event : std::uint8_t
+    {
+        initial_suspend,
+        resume,
+        suspend,
+        return_value,
+        final_suspend,
+        destroy
+    };
+
+    constexpr std::string_view to_string(Event event) noexcept
+    {
+        constexpr std::string_view names[] = {"initial_suspend", "resume", "suspend", "return", "final_suspend", "destroy"};
+        return names[static_cast<std::size_t>(event)];
+    }
+
+    inline std::uint64_t timestamp() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+    }
+
+    struct Record
+    {
+        std::uintptr_t frame_id;
+        std::uint64_t tsc;
+        std::uint32_t thread_id;
+        Event event;
+    };
+
+    // single producer (owning thread) ring buffer - the oldest records are overwritten;
+    // every slot is a seqlock, so readers on other threads skip slots that are being rewritten instead of tearing them
+    class ThreadBuffer
+    {
+    public:
+        static constexpr std::size_t capacity = 1 << 12;
+
+        explicit ThreadBuffer(std::uint32_t thread_id) noexcept
+            : thread_id_{thread_id}
+        {
+        }
+
+        void record(const void* frame, Event event) noexcept
+        {
+            const std::uint64_t head = head_.load(std::memory_order_relaxed);
+            Slot& slot = slots_[head & (capacity - 1)];
+
+            slot.sequence.store(2 * head + 1, std::memory_order_relaxed); // odd - being written
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.frame_id.store(reinterpret_cast<std::uintptr_t>(frame), std::memory_order_relaxed);
+            slot.tsc.store(timestamp(), std::memory_order_relaxed);
+            slot.event.store(event, std::memory_order_relaxed);
+            slot.sequence.store(2 * head + 2, std::memory_order_release);
+
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        // records written after the last clear() - safe to call while the owner is recording
+        template <typename F>
+        void for_each(F&& f) const
+        {
+            const std::uint64_t head = head_.load(std::memory_order_acquire);
+            const std::uint64_t first = std::max(head > capacity ? head - capacity : 0, begin_.load(std::memory_order_relaxed));
+            for (std::uint64_t i = first; i < head; ++i)
+            {
+                const Slot& slot = slots_[i & (capacity - 1)];
+
+                const std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+                if (sequence != 2 * i + 2)
+                    continue; // overwritten by a later lap
+
+                const Record record{slot.frame_id.load(std::memory_order_relaxed), slot.tsc.load(std::memory_order_relaxed), thread_id_,
+                    slot.event.load(std::memory_order_relaxed)};
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+                    f(record);
+            }
+        }
+
+        // hides the records written so far - the head is written only by the owner
+        void clear() noexcept
+        {
+            begin_.store(head_.load(std::memory_order_acquire), std::memory_order_relaxed);
+        }
+
+        // a buffer left by an exited thread handed over to a new one
+        void reuse(std::uint32_t thread_id) noexcept
+        {
+            clear();
+            thread_id_ = thread_id;
+        }
+
+    private:
+        struct Slot
+        {
+            std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::uintptr_t> frame_id{0};
+            std::atomic<std::uint64_t> tsc{0};
+            std::atomic<Event> event{};
+        };
+
+        std::atomic<std::uint64_t> head_{0};
+        std::atomic<std::uint64_t> begin_{0};
+        std::uint32_t thread_id_; // changed by reuse() under the lock of the Tracer
+        std::array<Slot, capacity> slots_;
+    };
+
+    // owns the per-thread buffers - the lock is taken only when a thread records its first event and when it exits;
+    // buffers of exited threads are reused, so there are at most as many buffers as threads recording at the same time
+    class Tracer
+    {
+    public:
+        static Tracer& instance()
+        {
+            static Tracer tracer;
+            return tracer;
+        }
+
+        void record(const void* frame, Event event) noexcept
+        {
+            thread_local const ThreadRegistration registration{*this};
+            registration.buffer->record(frame, event);
+        }
+
+        std::vector<Record> snapshot() const
+        {
+            std::vector<Record> records;
+
+            std::lock_guard lk{mtx_buffers_};
+            for (const auto& buffer : buffers_)
+                buffer->for_each([&records](const Record& r) { records.push_back(r); });
+
+            return records;
+        }
+
+        void clear()
+        {
+            std::lock_guard lk{mtx_buffers_};
+            for (const auto& buffer : buffers_)
+                buffer->clear();
+        }
+
+        std::size_t buffer_count() const
+        {
+            std::lock_guard lk{mtx_buffers_};
+            return buffers_.size();
+        }
+
+        // Chrome trace event format (chrome://tracing, Perfetto) - timestamps in microseconds since tracer start
+        void export_chrome_trace(std::ostream& out) const
+        {
+            const double ticks_per_us = calibrate();
+
+            out << "{\"traceEvents\":[";
+            bool first = true;
+            for (const Record& r : snapshot())
+            {
+                out << (first ? "" : ",") << "\n{\"name\":\"" << to_string(r.event) << "\",\"ph\":\"i\",\"s\":\"t\""
+                    << ",\"pid\":0,\"tid\":" << r.thread_id
+                    << ",\"ts\":" << static_cast<double>(r.tsc - start_tsc_) / ticks_per_us
+                    << ",\"args\":{\"frame\":\"0x" << std::hex << r.frame_id << std::dec << "\"}}";
+                first = false;
+            }
+            out << "\n]}\n";
+        }
+
+    private:
+        // the buffer of a thread - returned to the tracer when the thread exits
+        struct ThreadRegistration
+        {
+            Tracer& tracer;
+            ThreadBuffer* buffer;
+
+            explicit ThreadRegistration(Tracer& tracer)
+                : tracer{tracer}
+                , buffer{tracer.acquire_buffer()}
+            {
+            }
+
+            ThreadRegistration(const ThreadRegistration&) = delete;
+            ThreadRegistration& operator=(const ThreadRegistration&) = delete;
+
+            ~ThreadRegistration()
+            {
+                tracer.release_buffer(buffer);
+            }
+        };
+
+        mutable std::mutex mtx_buffers_;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+        std::vector<ThreadBuffer*> free_buffers_;
+        std::uint32_t next_thread_id_ = 0;
+        const std::uint64_t start_tsc_ = timestamp();
+        const std::chrono::steady_clock::time_point start_time_ = std::chrono::steady_clock::now();
+
+        Tracer() = default;
+
+        ThreadBuffer* acquire_buffer()
+        {
+            std::lock_guard lk{mtx_buffers_};
+            if (!free_buffers_.empty())
+            {
+                ThreadBuffer* buffer = free_buffers_.back();
+                free_buffers_.pop_back();
+                buffer->reuse(next_thread_id_++);
+                return buffer;
+            }
+
+            return buffers_.emplace_back(std::make_unique<ThreadBuffer>(next_thread_id_++)).get();
+        }
+
+        // records of an exited thread stay visible until its buffer is reused
+        void release_buffer(ThreadBuffer* buffer)
+        {
+            std::lock_guard lk{mtx_buffers_};
+            free_buffers_.push_back(buffer);
+        }
+
+        double calibrate() const
+        {
+            const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start_time_);
+            const auto ticks = static_cast<double>(timestamp() - start_tsc_);
+
+            return elapsed.count() > 0 && ticks > 0 ? ticks / elapsed.count() : 1.0;
+        }
+    };
+} // namespace coro::trace
+
+// compiles to nothing unless the build defines CORO_TRACE_ENABLED (cmake -DCORO_TRACE=ON)
+#ifdef CORO_TRACE_ENABLED
+#define CORO_TRACE_EVENT(frame, event) ::coro::trace::Tracer::instance().record((frame), ::coro::trace::Event::event)
+#else
+#define CORO_TRACE_EVENT(frame, event) static_cast<void>(0)
+#endif
+
+#endif
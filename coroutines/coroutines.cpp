@@ -1,9 +1,12 @@
+#include "async_scope.hpp"
+#include "coro_trace.hpp"
+
 #include <catch2/catch_test_macros.hpp>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <coroutine>
-#include <syncstream>
+#include <thread>
 
 using namespace std::literals;
 
@@ -22,19 +25,19 @@ public:
 
         auto initial_suspend()
         {
-            std::cout << "Initial suspension point..." << std::endl;
+            CORO_TRACE_EVENT(CoroHandle::from_promise(*this).address(), initial_suspend);
             return std::suspend_always{};
         }
 
         auto final_suspend() noexcept
         {
-            std::cout << "Final suspension point..." << std::endl;
+            CORO_TRACE_EVENT(CoroHandle::from_promise(*this).address(), final_suspend);
             return std::suspend_always{};
         }
 
         void return_void()
         {
-            std::cout << "Returning void" << std::endl;
+            CORO_TRACE_EVENT(CoroHandle::from_promise(*this).address(), return_value);
         }
 
         void unhandled_exception() 
@@ -52,7 +55,10 @@ public:
     ~TaskResumer()
     {
         if (coro_hndl_)
+        {
+            CORO_TRACE_EVENT(coro_hndl_.address(), destroy);
             coro_hndl_.destroy();
+        }
     }
 
     bool resume() const
@@ -60,6 +66,7 @@ public:
         if (!coro_hndl_ || coro_hndl_.done())
             return false;
 
+        CORO_TRACE_EVENT(coro_hndl_.address(), resume);
         coro_hndl_.resume();
 
         return !coro_hndl_.done();
@@ -136,17 +143,23 @@ concept Awaiter = requires(T obj, std::coroutine_handle<Promise...> coro_hndl) {
 static_assert(Awaiter<std::suspend_always>);
 static_assert(Awaiter<std::suspend_never>);
 
-inline auto sync_out(std::ostream& out = std::cout)
-{
-    return std::osyncstream{out};
-}
-
 class FireAndForget
 {
 public:
     class promise_type
     {
+        coro::AsyncScope* scope_ = nullptr;
+
     public:
+        promise_type() = default;
+
+        // coroutine with AsyncScope& as the first parameter is tracked by the scope
+        template <typename... TArgs>
+        promise_type(coro::AsyncScope& scope, TArgs&&...) : scope_{&scope}
+        {
+            scope.on_work_started();
+        }
+
         FireAndForget get_return_object()
         {
             return {};
@@ -154,14 +167,26 @@ public:
 
         auto initial_suspend()
         {
-            sync_out() << "...Initial suspension point...\n";
+            CORO_TRACE_EVENT(std::coroutine_handle<promise_type>::from_promise(*this).address(), initial_suspend);
             return std::suspend_never{};
         }
 
         auto final_suspend() noexcept
         {
-            sync_out() << "...Final suspension point...\n";
-            return std::suspend_never{};
+            CORO_TRACE_EVENT(std::coroutine_handle<promise_type>::from_promise(*this).address(), final_suspend);
+
+            struct ReleaseScope : std::suspend_always
+            {
+                void await_suspend(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                {
+                    coro::AsyncScope* scope = coro_hndl.promise().scope_;
+                    coro_hndl.destroy();
+                    if (scope)
+                        scope->on_work_finished();
+                }
+            };
+
+            return ReleaseScope{};
         }
 
         void return_void()
@@ -199,7 +224,7 @@ auto resume_on_new_thread()
     return ResumeOnNewThreadAwaiter{};
 }
 
-FireAndForget fire_and_forget_test()
+FireAndForget fire_and_forget_test(coro::AsyncScope&)
 {
     std::cout << "Start on thread#" << std::this_thread::get_id() << "..." << std::endl;
 
@@ -214,7 +239,9 @@ FireAndForget fire_and_forget_test()
 
 TEST_CASE("fire and forget")
 {
-    auto fire_on_threads = fire_and_forget_test();
+    coro::AsyncScope scope;
+
+    fire_and_forget_test(scope);
 
-    std::this_thread::sleep_for(2s);
+    coro::sync_wait(scope.join());
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "async_scope.hpp"
+#include "event_loop.hpp"
+#include "task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    coro::Task<> append_on_loop(coro::EventLoop& loop, std::vector<int>& order, int value)
+    {
+        co_await loop.schedule();
+        order.push_back(value);
+    }
+
+    coro::Task<std::thread::id> thread_on_loop(coro::EventLoop& loop)
+    {
+        co_await loop.schedule();
+        co_return std::this_thread::get_id();
+    }
+
+    coro::Task<> reschedule_until(coro::EventLoop& loop, const std::atomic<bool>& done, int& reschedules)
+    {
+        while (!done)
+        {
+            co_await loop.schedule();
+            ++reschedules;
+        }
+    }
+} // namespace
+
+TEST_CASE("event loop - drained on the calling thread")
+{
+    coro::EventLoop loop{2};
+    std::vector<int> order;
+
+    coro::AsyncScope scope;
+    for (int i = 0; i < 5; ++i)
+        scope.spawn(append_on_loop(loop, order, i)); // runs until co_await loop.schedule()
+
+    loop.drain();
+    coro::sync_wait(scope.join());
+
+    SECTION("coroutines are resumed in FIFO order")
+    {
+        REQUIRE(order == std::vector{0, 1, 2, 3, 4});
+    }
+
+    SECTION("at most max_batch_size coroutines per iteration")
+    {
+        const auto& stats = loop.stats();
+        REQUIRE(stats.iterations == 3);
+        REQUIRE(stats.resumed == 5);
+        REQUIRE(stats.max_queue_depth == 5);
+        REQUIRE(stats.last_iteration.queue_depth == 1);
+        REQUIRE(stats.last_iteration.resumed == 1);
+    }
+}
+
+TEST_CASE("event loop - remote work taken while a coroutine keeps rescheduling itself")
+{
+    coro::EventLoop loop;
+    std::atomic<bool> posted_done{false};
+    int reschedules = 0;
+
+    coro::AsyncScope scope;
+    scope.spawn(reschedule_until(loop, posted_done, reschedules));
+    REQUIRE(loop.run_once()); // from now on the coroutine reschedules itself on the local queue
+
+    std::jthread{[&] { loop.post([&] { posted_done = true; }); }}.join();
+
+    loop.drain();
+    coro::sync_wait(scope.join());
+
+    REQUIRE(posted_done);
+    REQUIRE(reschedules >= 1);
+}
+
+TEST_CASE("event loop - schedule & post from other threads")
+{
+    coro::EventLoop loop;
+    std::atomic<std::thread::id> loop_thread_id;
+
+    std::jthread loop_thread{[&](std::stop_token stop_tkn) {
+        loop_thread_id = std::this_thread::get_id();
+        loop.run(stop_tkn);
+    }};
+
+    SECTION("co_await schedule() continues on the loop thread")
+    {
+        const std::thread::id resumed_on = coro::sync_wait(thread_on_loop(loop));
+        REQUIRE(resumed_on == loop_thread_id.load());
+    }
+
+    SECTION("posted callables run on the loop thread")
+    {
+        constexpr int producers_count = 4;
+        constexpr int posts_per_producer = 1'000;
+
+        std::atomic<int> counter{0};
+        std::atomic<bool> all_on_loop{true};
+
+        {
+            std::vector<std::jthread> producers;
+            for (int i = 0; i < producers_count; ++i)
+                producers.emplace_back([&] {
+                    for (int j = 0; j < posts_per_producer; ++j)
+                        loop.post([&] {
+                            all_on_loop = all_on_loop && loop.is_loop_thread();
+                            ++counter;
+                        });
+                });
+        }
+
+        while (counter < producers_count * posts_per_producer)
+            std::this_thread::yield();
+
+        REQUIRE(all_on_loop);
+    }
+
+    SECTION("caller-owned post operations")
+    {
+        std::atomic<std::thread::id> ran_on;
+        std::atomic<bool> done{false};
+        auto record = [&] {
+            ran_on = std::this_thread::get_id();
+            done = true;
+        };
+
+        coro::EventLoop::PostOperation<decltype(record)> operation{record}; // outlives the callable's run
+        std::jthread{[&] { loop.post(operation); }}.join();
+
+        while (!done)
+            std::this_thread::yield();
+
+        REQUIRE(ran_on.load() == loop_thread_id.load());
+    }
+}
@@ -0,0 +1,354 @@
+#ifndef EVENT_LOOP_HPP
+#define EVENT_LOOP_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <unistd.h>
+#endif
+
+namespace coro
+{
+    // single threaded executor - coroutines scheduled on the loop are resumed only by the thread calling run()
+    class EventLoop
+    {
+    public:
+        // intrusive queue node - lives in the frame of the suspended coroutine or is owned by the caller of post()
+        class Operation
+        {
+        protected:
+            explicit Operation(void (*run)(Operation*) noexcept) noexcept
+                : run_{run}
+            {
+            }
+
+            Operation(const Operation&) = delete;
+            Operation& operator=(const Operation&) = delete;
+
+        private:
+            friend class EventLoop;
+
+            void (*run_)(Operation*) noexcept;
+            Operation* next_ = nullptr;
+        };
+
+        class ScheduleOperation : public Operation
+        {
+        public:
+            explicit ScheduleOperation(EventLoop& loop) noexcept
+                : Operation{&resume}
+                , loop_{loop}
+            {
+            }
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(std::coroutine_handle<> coro_hndl) noexcept
+            {
+                coro_hndl_ = coro_hndl;
+                loop_.enqueue(this);
+            }
+
+            void await_resume() const noexcept { }
+
+        private:
+            EventLoop& loop_;
+            std::coroutine_handle<> coro_hndl_;
+
+            static void resume(Operation* operation) noexcept
+            {
+                static_cast<ScheduleOperation*>(operation)->coro_hndl_.resume();
+            }
+        };
+
+        // callable posted without allocation - the node must stay alive until the callable has run on the loop thread
+        template <std::invocable F>
+        class PostOperation : public Operation
+        {
+        public:
+            explicit PostOperation(F f)
+                : Operation{&run}
+                , f_{std::move(f)}
+            {
+            }
+
+        private:
+            F f_;
+
+            static void run(Operation* operation) noexcept // an exception thrown by the callable terminates
+            {
+                static_cast<PostOperation*>(operation)->f_();
+            }
+        };
+
+        struct IterationStats
+        {
+            std::size_t queue_depth = 0; // coroutines ready at the start of the iteration
+            std::size_t resumed = 0;
+            std::chrono::nanoseconds user_time{};
+        };
+
+        struct Stats
+        {
+            std::uint64_t iterations = 0;
+            std::uint64_t resumed = 0;
+            std::size_t max_queue_depth = 0;
+            std::chrono::nanoseconds user_time{};
+            IterationStats last_iteration;
+        };
+
+        explicit EventLoop(std::size_t max_batch_size = 64)
+            : max_batch_size_{max_batch_size}
+        {
+#ifdef __linux__
+            wakeup_fd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (wakeup_fd_ == -1)
+                throw std::system_error(errno, std::system_category(), "eventfd");
+#endif
+        }
+
+        EventLoop(const EventLoop&) = delete;
+        EventLoop& operator=(const EventLoop&) = delete;
+
+        ~EventLoop()
+        {
+#ifdef __linux__
+            ::close(wakeup_fd_);
+#endif
+        }
+
+        // co_await loop.schedule() - continues the coroutine on the loop thread; safe to call from any thread
+        [[nodiscard]] ScheduleOperation schedule() noexcept
+        {
+            return ScheduleOperation{*this};
+        }
+
+        // runs the callable of a caller-owned node on the loop thread - nothing is allocated; safe to call from any thread
+        template <typename F>
+        void post(PostOperation<F>& operation) noexcept
+        {
+            enqueue(&operation);
+        }
+
+        // runs the callable on the loop thread - the node is allocated here and freed after the callable has run;
+        // use the PostOperation overload on hot paths
+        template <std::invocable F>
+        void post(F&& f)
+        {
+            enqueue(new OwnedPostOperation<std::decay_t<F>>{std::forward<F>(f)});
+        }
+
+        // runs until stop is requested; ready coroutines are resumed in batches of at most max_batch_size
+        void run(std::stop_token stop_tkn = {})
+        {
+            std::stop_callback wake_on_stop{stop_tkn, [this] { wake_up(); }};
+
+            while (!stop_tkn.stop_requested())
+            {
+                if (!run_once())
+                    wait_for_work(stop_tkn);
+            }
+        }
+
+        // resumes ready coroutines until the queue is empty - used by tests and by callers that own the thread
+        void drain()
+        {
+            while (run_once())
+            { }
+        }
+
+        // returns false if there was nothing to resume
+        bool run_once()
+        {
+            loop_thread_.store(current_thread_tag(), std::memory_order_relaxed);
+
+            take_remote(); // every iteration - a coroutine rescheduling itself must not starve other threads
+
+            if (!ready_head_)
+                return false;
+
+            IterationStats iteration{ready_size_, 0, {}};
+
+            const auto start = std::chrono::steady_clock::now();
+            while (ready_head_ && iteration.resumed < max_batch_size_)
+            {
+                Operation* operation = std::exchange(ready_head_, ready_head_->next_);
+                if (!ready_head_)
+                    ready_tail_ = nullptr;
+                --ready_size_;
+                ++iteration.resumed;
+                operation->run_(operation); // the operation may be destroyed here
+            }
+            iteration.user_time = std::chrono::steady_clock::now() - start;
+
+            ++stats_.iterations;
+            stats_.resumed += iteration.resumed;
+            stats_.max_queue_depth = std::max(stats_.max_queue_depth, iteration.queue_depth);
+            stats_.user_time += iteration.user_time;
+            stats_.last_iteration = iteration;
+
+            return true;
+        }
+
+        const Stats& stats() const noexcept
+        {
+            return stats_;
+        }
+
+        bool is_loop_thread() const noexcept
+        {
+            return loop_thread_.load(std::memory_order_relaxed) == current_thread_tag();
+        }
+
+    private:
+        template <typename F>
+        class OwnedPostOperation : public Operation
+        {
+        public:
+            explicit OwnedPostOperation(F f)
+                : Operation{&run}
+                , f_{std::move(f)}
+            {
+            }
+
+        private:
+            F f_;
+
+            static void run(Operation* operation) noexcept
+            {
+                std::unique_ptr<OwnedPostOperation> self{static_cast<OwnedPostOperation*>(operation)};
+                self->f_();
+            }
+        };
+
+        const std::size_t max_batch_size_;
+
+        // ready queue - touched only by the loop thread
+        Operation* ready_head_ = nullptr;
+        Operation* ready_tail_ = nullptr;
+        std::size_t ready_size_ = 0;
+
+        // remote queue - lock-free stack pushed by any thread (MPSC), taken as a whole by the loop thread
+        std::atomic<Operation*> remote_head_{nullptr};
+        std::atomic<bool> sleeping_{false};
+        std::atomic<const void*> loop_thread_{nullptr};
+        Stats stats_;
+
+#ifdef __linux__
+        int wakeup_fd_ = -1;
+#else
+        std::atomic<std::uint32_t> wakeup_epoch_{0};
+#endif
+
+        static const void* current_thread_tag() noexcept
+        {
+            static thread_local const char tag{};
+            return &tag;
+        }
+
+        void enqueue(Operation* operation) noexcept
+        {
+            if (is_loop_thread())
+            {
+                operation->next_ = nullptr;
+                if (ready_tail_)
+                    ready_tail_->next_ = operation;
+                else
+                    ready_head_ = operation;
+                ready_tail_ = operation;
+                ++ready_size_;
+                return;
+            }
+
+            Operation* head = remote_head_.load(std::memory_order_relaxed);
+            do
+            {
+                operation->next_ = head;
+            } while (!remote_head_.compare_exchange_weak(head, operation, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+            if (head == nullptr && sleeping_.load(std::memory_order_seq_cst))
+                wake_up();
+        }
+
+        // appends remote operations to the ready queue restoring FIFO order
+        void take_remote() noexcept
+        {
+            if (remote_head_.load(std::memory_order_relaxed) == nullptr)
+                return;
+
+            Operation* reversed = remote_head_.exchange(nullptr, std::memory_order_acquire);
+            Operation* head = nullptr;
+            std::size_t count = 0;
+            while (reversed)
+            {
+                Operation* next = reversed->next_;
+                reversed->next_ = head;
+                head = reversed;
+                reversed = next;
+                ++count;
+            }
+
+            if (!head)
+                return;
+
+            if (ready_tail_)
+                ready_tail_->next_ = head;
+            else
+                ready_head_ = head;
+
+            ready_tail_ = head;
+            while (ready_tail_->next_)
+                ready_tail_ = ready_tail_->next_;
+            ready_size_ += count;
+        }
+
+        void wait_for_work(const std::stop_token& stop_tkn)
+        {
+            sleeping_.store(true, std::memory_order_seq_cst);
+#ifndef __linux__
+            const std::uint32_t epoch = wakeup_epoch_.load(std::memory_order_acquire);
+#endif
+
+            if (remote_head_.load(std::memory_order_seq_cst) == nullptr && !stop_tkn.stop_requested())
+            {
+#ifdef __linux__
+                pollfd fd{wakeup_fd_, POLLIN, 0};
+                ::poll(&fd, 1, -1);
+                std::uint64_t value;
+                [[maybe_unused]] auto result = ::read(wakeup_fd_, &value, sizeof(value));
+#else
+                wakeup_epoch_.wait(epoch);
+#endif
+            }
+
+            sleeping_.store(false, std::memory_order_relaxed);
+        }
+
+        void wake_up() noexcept
+        {
+#ifdef __linux__
+            const std::uint64_t one = 1;
+            [[maybe_unused]] auto result = ::write(wakeup_fd_, &one, sizeof(one));
+#else
+            wakeup_epoch_.fetch_add(1, std::memory_order_release);
+            wakeup_epoch_.notify_one();
+#endif
+        }
+    };
+} // namespace coro
+
+#endif
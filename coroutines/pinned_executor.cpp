@@ -0,0 +1,181 @@
+#include "async_generator.hpp"
+#include "pinned_executor.hpp"
+#include "task.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace
+{
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        int allocations = 0;
+        int deallocations = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            ++deallocations;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    coro::Task<int> add(std::allocator_arg_t, std::pmr::memory_resource*, int a, int b)
+    {
+        co_return a + b;
+    }
+
+    struct Adder
+    {
+        int base;
+
+        coro::Task<int> add(std::allocator_arg_t, std::pmr::memory_resource*, int a)
+        {
+            co_return base + a;
+        }
+    };
+
+    coro::AsyncGenerator<int> count_to(std::allocator_arg_t, std::pmr::memory_resource*, int n)
+    {
+        for (int i = 1; i <= n; ++i)
+            co_yield i;
+    }
+
+    coro::Task<int> sum(coro::AsyncGenerator<int> gen)
+    {
+        int total = 0;
+        while (int* value = co_await gen.next())
+            total += *value;
+        co_return total;
+    }
+
+    coro::Task<int> current_cpu_after_resume_on(coro::PinnedExecutor& executor, int cpu)
+    {
+        co_await coro::resume_on(executor, cpu);
+#ifdef __linux__
+        co_return sched_getcpu();
+#else
+        co_return executor.current_cpu();
+#endif
+    }
+
+    std::vector<int> first_cpus(std::size_t count)
+    {
+        auto cpus = coro::topology::numa_nodes().front().cpus;
+        cpus.resize(std::min(count, cpus.size()));
+        return cpus;
+    }
+} // namespace
+
+TEST_CASE("cpu topology")
+{
+    SECTION("cpu list format")
+    {
+        REQUIRE(coro::topology::parse_cpu_list("0-3,8,10-11\n") == std::vector{0, 1, 2, 3, 8, 10, 11});
+        REQUIRE(coro::topology::parse_cpu_list("").empty());
+        REQUIRE_THROWS_AS(coro::topology::parse_cpu_list("0-x"), std::invalid_argument);
+    }
+
+    SECTION("numa nodes read from sysfs")
+    {
+        const auto sysfs = std::filesystem::temp_directory_path() / "pinned_executor_test_nodes";
+        std::filesystem::remove_all(sysfs);
+        for (auto [node, cpulist] : {std::pair{"node1", "4-7\n"}, std::pair{"node0", "0-3\n"}, std::pair{"node2", "\n"}})
+        {
+            std::filesystem::create_directories(sysfs / node);
+            std::ofstream{sysfs / node / "cpulist"} << cpulist;
+        }
+        std::filesystem::create_directories(sysfs / "power");
+
+        auto nodes = coro::topology::numa_nodes(sysfs);
+        std::filesystem::remove_all(sysfs);
+
+        REQUIRE(nodes.size() == 2); // memory-only node2 is skipped
+        REQUIRE(nodes[0].id == 0);
+        REQUIRE(nodes[0].cpus == std::vector{0, 1, 2, 3});
+        REQUIRE(nodes[1].id == 1);
+        REQUIRE(nodes[1].cpus == std::vector{4, 5, 6, 7});
+    }
+
+    SECTION("missing sysfs - single node with all cpus")
+    {
+        auto nodes = coro::topology::numa_nodes("/nonexistent");
+
+        REQUIRE(nodes.size() == 1);
+        REQUIRE(nodes[0].cpus.size() == std::max(1u, std::thread::hardware_concurrency()));
+    }
+}
+
+TEST_CASE("pinned executor")
+{
+    const auto cpus = first_cpus(2);
+    coro::PinnedExecutor executor{cpus};
+
+    SECTION("resume_on continues on the worker pinned to the cpu")
+    {
+        for (int cpu : cpus)
+        {
+            const int resumed_on = coro::sync_wait(current_cpu_after_resume_on(executor, cpu));
+            if (executor.is_pinned(cpu)) // affinity may be restricted in containers
+                REQUIRE(resumed_on == cpu);
+        }
+    }
+
+    SECTION("unknown cpu")
+    {
+        REQUIRE_THROWS_AS(executor.schedule(-1), std::out_of_range);
+    }
+
+    SECTION("frames allocated from the executor's resource")
+    {
+        REQUIRE(coro::sync_wait(add(std::allocator_arg, executor.frame_resource(), 1, 2)) == 3);
+    }
+}
+
+TEST_CASE("coroutine frame allocation from a memory resource")
+{
+    CountingResource resource;
+
+    SECTION("task")
+    {
+        REQUIRE(coro::sync_wait(add(std::allocator_arg, &resource, 40, 2)) == 42);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(resource.deallocations == 1);
+    }
+
+    SECTION("member task")
+    {
+        Adder adder{40};
+        REQUIRE(coro::sync_wait(adder.add(std::allocator_arg, &resource, 2)) == 42);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(resource.deallocations == 1);
+    }
+
+    SECTION("generator")
+    {
+        REQUIRE(coro::sync_wait(sum(count_to(std::allocator_arg, &resource, 4))) == 10);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(resource.deallocations == 1);
+    }
+}
@@ -0,0 +1,316 @@
+#ifndef PINNED_EXECUTOR_HPP
+#define PINNED_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace coro
+{
+    namespace topology
+    {
+        struct NumaNode
+        {
+            int id;
+            std::vector<int> cpus;
+        };
+
+        // parses the kernel's cpu list format: "0-3,8,10-11"
+        inline std::vector<int> parse_cpu_list(std::string_view cpu_list)
+        {
+            std::vector<int> cpus;
+
+            auto parse_int = [](std::string_view text) {
+                int value{};
+                auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+                if (ec != std::errc{} || ptr != text.data() + text.size())
+                    throw std::invalid_argument{"invalid cpu list: " + std::string{text}};
+                return value;
+            };
+
+            while (!cpu_list.empty())
+            {
+                const auto comma = cpu_list.find(',');
+                std::string_view range = cpu_list.substr(0, comma);
+                cpu_list.remove_prefix(comma == std::string_view::npos ? cpu_list.size() : comma + 1);
+
+                while (!range.empty() && (range.back() == '\n' || range.back() == ' '))
+                    range.remove_suffix(1);
+                if (range.empty())
+                    continue;
+
+                if (const auto dash = range.find('-'); dash != std::string_view::npos)
+                {
+                    for (int cpu = parse_int(range.substr(0, dash)), last = parse_int(range.substr(dash + 1)); cpu <= last; ++cpu)
+                        cpus.push_back(cpu);
+                }
+                else
+                    cpus.push_back(parse_int(range));
+            }
+
+            return cpus;
+        }
+
+        // NUMA nodes described in sysfs; a machine without that information is a single node with all cpus
+        inline std::vector<NumaNode> numa_nodes(const std::filesystem::path& sysfs_nodes = "/sys/devices/system/node")
+        {
+            std::vector<NumaNode> nodes;
+
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator{sysfs_nodes, ec})
+            {
+                const std::string name = entry.path().filename().string();
+                if (!name.starts_with("node") || name.size() == 4 || !std::ranges::all_of(name.substr(4), [](char c) { return c >= '0' && c <= '9'; }))
+                    continue;
+
+                std::ifstream cpulist_file{entry.path() / "cpulist"};
+                std::string cpulist;
+                if (!std::getline(cpulist_file, cpulist))
+                    continue;
+
+                if (auto cpus = parse_cpu_list(cpulist); !cpus.empty()) // memory-only nodes have no cpus
+                    nodes.push_back(NumaNode{std::stoi(name.substr(4)), std::move(cpus)});
+            }
+
+            if (nodes.empty())
+            {
+                NumaNode node{0, {}};
+                for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu)
+                    node.cpus.push_back(static_cast<int>(cpu));
+                nodes.push_back(std::move(node));
+            }
+
+            std::ranges::sort(nodes, {}, &NumaNode::id);
+            return nodes;
+        }
+
+        // returns false if the platform does not support pinning or the cpu is not available to the process
+        inline bool pin_current_thread(int cpu) noexcept
+        {
+#ifdef __linux__
+            cpu_set_t cpu_set;
+            CPU_ZERO(&cpu_set);
+            CPU_SET(cpu, &cpu_set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+            return false;
+#endif
+        }
+    } // namespace topology
+
+    // executor with one worker pinned to each of the given cpus - work is queued per worker,
+    // so a coroutine resumed on a core stays there until it explicitly moves
+    class PinnedExecutor
+    {
+        struct Worker
+        {
+            int cpu;
+            std::atomic<bool> pinned{false};
+            std::mutex mtx_jobs;
+            std::condition_variable_any cv_jobs;
+            std::deque<std::function<void()>> jobs;
+            std::jthread thread; // must be the last member - joined before the queue is destroyed
+
+            explicit Worker(int cpu)
+                : cpu{cpu}
+            {
+            }
+        };
+
+    public:
+        explicit PinnedExecutor(std::vector<int> cpus, int numa_node = 0)
+            : numa_node_{numa_node}
+        {
+            if (cpus.empty())
+                throw std::invalid_argument{"PinnedExecutor needs at least one cpu"};
+
+            workers_.reserve(cpus.size());
+            for (int cpu : cpus)
+                workers_.push_back(std::make_unique<Worker>(cpu));
+
+            for (std::size_t index = 0; index < workers_.size(); ++index)
+                workers_[index]->thread = std::jthread{[this, index](std::stop_token stop_tkn) { run(index, stop_tkn); }};
+        }
+
+        explicit PinnedExecutor(const topology::NumaNode& node)
+            : PinnedExecutor{node.cpus, node.id}
+        {
+        }
+
+        PinnedExecutor(const PinnedExecutor&) = delete;
+        PinnedExecutor& operator=(const PinnedExecutor&) = delete;
+
+        ~PinnedExecutor()
+        {
+            for (auto& worker : workers_) // queued jobs are drained before workers exit
+                worker->thread.request_stop();
+            for (auto& worker : workers_)
+                worker->thread.join();
+        }
+
+        std::size_t size() const noexcept
+        {
+            return workers_.size();
+        }
+
+        int numa_node() const noexcept
+        {
+            return numa_node_;
+        }
+
+        std::vector<int> cpus() const
+        {
+            std::vector<int> cpus;
+            for (const auto& worker : workers_)
+                cpus.push_back(worker->cpu);
+            return cpus;
+        }
+
+        // false until the worker has started or if the affinity could not be set
+        bool is_pinned(int cpu) const
+        {
+            return worker_for(cpu).pinned.load(std::memory_order_acquire);
+        }
+
+        // cpu of the worker running the calling thread; -1 outside of this executor
+        int current_cpu() const noexcept
+        {
+            return current_executor_ == this ? workers_[current_worker_]->cpu : -1;
+        }
+
+        // round robin over the workers
+        template <std::invocable F>
+        void submit(F&& job)
+        {
+            const std::size_t index = next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+            enqueue(*workers_[index], std::forward<F>(job));
+        }
+
+        template <std::invocable F>
+        void submit(int cpu, F&& job)
+        {
+            enqueue(worker_for(cpu), std::forward<F>(job));
+        }
+
+        // co_await executor.schedule(cpu) - resumes the coroutine on the worker pinned to the cpu
+        auto schedule(int cpu)
+        {
+            struct ScheduleAwaiter
+            {
+                PinnedExecutor& executor;
+                Worker& worker;
+
+                bool await_ready() const noexcept
+                {
+                    return executor.current_cpu() == worker.cpu;
+                }
+
+                void await_suspend(std::coroutine_handle<> coro_hndl)
+                {
+                    executor.enqueue(worker, [coro_hndl] { coro_hndl.resume(); });
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+            return ScheduleAwaiter{*this, worker_for(cpu)};
+        }
+
+        // frames allocated from it are first touched by the allocating thread - coroutines started on the
+        // executor's workers get node-local frames: Task<T> stage(std::allocator_arg_t, std::pmr::memory_resource*, ...)
+        std::pmr::memory_resource* frame_resource() noexcept
+        {
+            return &frame_pool_;
+        }
+
+    private:
+        const int numa_node_;
+        std::atomic<std::size_t> next_worker_{0};
+        std::pmr::synchronized_pool_resource frame_pool_;
+        std::vector<std::unique_ptr<Worker>> workers_; // must be the last member - joined first
+
+        inline static thread_local const PinnedExecutor* current_executor_ = nullptr;
+        inline static thread_local std::size_t current_worker_ = 0;
+
+        Worker& worker_for(int cpu) const
+        {
+            auto it = std::ranges::find(workers_, cpu, [](const auto& worker) { return worker->cpu; });
+            if (it == workers_.end())
+                throw std::out_of_range{"no worker pinned to cpu " + std::to_string(cpu)};
+
+            return **it;
+        }
+
+        template <typename F>
+        void enqueue(Worker& worker, F&& job)
+        {
+            {
+                std::lock_guard lk{worker.mtx_jobs};
+                worker.jobs.emplace_back(std::forward<F>(job));
+            }
+            worker.cv_jobs.notify_one();
+        }
+
+        void run(std::size_t index, std::stop_token stop_tkn)
+        {
+            Worker& worker = *workers_[index];
+            worker.pinned.store(topology::pin_current_thread(worker.cpu), std::memory_order_release);
+            current_executor_ = this;
+            current_worker_ = index;
+
+            while (true)
+            {
+                std::function<void()> job;
+                {
+                    std::unique_lock lk{worker.mtx_jobs};
+                    if (!worker.cv_jobs.wait(lk, stop_tkn, [&worker] { return !worker.jobs.empty(); }))
+                        return;
+
+                    job = std::move(worker.jobs.front());
+                    worker.jobs.pop_front();
+                }
+
+                job();
+            }
+        }
+    };
+
+    // co_await resume_on(executor, cpu)
+    inline auto resume_on(PinnedExecutor& executor, int cpu)
+    {
+        return executor.schedule(cpu);
+    }
+
+    // one pinned executor per NUMA node
+    inline std::vector<std::unique_ptr<PinnedExecutor>> make_numa_executors(const std::vector<topology::NumaNode>& nodes = topology::numa_nodes())
+    {
+        std::vector<std::unique_ptr<PinnedExecutor>> executors;
+        for (const auto& node : nodes)
+            executors.push_back(std::make_unique<PinnedExecutor>(node));
+        return executors;
+    }
+} // namespace coro
+
+#endif
@@ -0,0 +1,131 @@
+#include "record_parser.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    // the exercise data from _exercises/ex-ranges as a byte stream
+    constexpr std::string_view input = "# Comment 1\n"
+                                       "# Comment 2\n"
+                                       "# Comment 3\n"
+                                       "1/one\n"
+                                       "2/two\n"
+                                       "\n"
+                                       "3/three\n"
+                                       "4/four\n"
+                                       "5/five\n"
+                                       "\n"
+                                       "\n"
+                                       "6/six";
+
+    using Records = std::vector<std::pair<std::string, std::string>>;
+
+    void collect(coro::RecordParser::Records records, Records& result)
+    {
+        for (const auto& [id, name] : records)
+            result.emplace_back(id, name);
+    }
+
+    Records parse_in_chunks(std::string_view text, size_t chunk_size)
+    {
+        Records result;
+        coro::RecordParser parser;
+
+        for (size_t pos = 0; pos < text.size(); pos += chunk_size)
+        {
+            std::string chunk{text.substr(pos, chunk_size)}; // the chunk is gone after feed - as with network buffers
+            collect(parser.feed(chunk), result);
+        }
+        collect(parser.finish(), result);
+
+        return result;
+    }
+
+    std::string make_large_input(size_t records_count)
+    {
+        std::string text = "# generated\n";
+        for (size_t i = 0; i < records_count; ++i)
+            text += std::to_string(i) + "/name-" + std::to_string(i) + "\n";
+        return text;
+    }
+} // namespace
+
+TEST_CASE("incremental record parser")
+{
+    const Records expected = {{"1", "one"}, {"2", "two"}, {"3", "three"}, {"4", "four"}, {"5", "five"}, {"6", "six"}};
+
+    SECTION("contiguous input")
+    {
+        REQUIRE(parse_in_chunks(input, input.size()) == expected);
+    }
+
+    SECTION("any chunk size gives the same records")
+    {
+        for (size_t chunk_size = 1; chunk_size < input.size(); ++chunk_size)
+            REQUIRE(parse_in_chunks(input, chunk_size) == expected);
+    }
+
+    SECTION("comments only at the beginning - later '#' lines are records")
+    {
+        REQUIRE(parse_in_chunks("# header\n1/one\n#2/two\n", 3) == Records{{"1", "one"}, {"#2", "two"}});
+    }
+
+    SECTION("line without a separator gives an empty record")
+    {
+        REQUIRE(parse_in_chunks("1/one\n4343\n", 4) == Records{{"1", "one"}, {"", ""}});
+    }
+
+    SECTION("records are available as soon as their line is complete")
+    {
+        coro::RecordParser parser;
+        Records result;
+
+        collect(parser.feed("# comment\n1/o"), result);
+        REQUIRE(result.empty());
+
+        collect(parser.feed("ne\n2/tw"), result);
+        REQUIRE(result == Records{{"1", "one"}});
+
+        collect(parser.feed("o"), result);
+        REQUIRE(result == Records{{"1", "one"}});
+
+        collect(parser.finish(), result); // the last line has no trailing '\n'
+        REQUIRE(result == Records{{"1", "one"}, {"2", "two"}});
+    }
+}
+
+TEST_CASE("incremental record parser - 64 KB chunks vs contiguous", "[.][benchmark]")
+{
+    const std::string text = make_large_input(1'000'000);
+
+    auto count_records = [](coro::RecordParser::Records records) {
+        return std::ranges::distance(records.begin(), records.end());
+    };
+
+    BENCHMARK("contiguous")
+    {
+        coro::RecordParser parser;
+        return count_records(parser.feed(text)) + count_records(parser.finish());
+    };
+
+    BENCHMARK("64 KB chunks")
+    {
+        constexpr size_t chunk_size = 64 * 1024;
+
+        coro::RecordParser parser;
+        std::ptrdiff_t count = 0;
+        for (size_t pos = 0; pos < text.size(); pos += chunk_size)
+            count += count_records(parser.feed(std::string_view{text}.substr(pos, chunk_size)));
+        return count + count_records(parser.finish());
+    };
+}
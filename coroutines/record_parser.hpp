@@ -0,0 +1,259 @@
+#ifndef RECORD_PARSER_HPP
+#define RECORD_PARSER_HPP
+
+#include <cassert>
+#include <coroutine>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace coro
+{
+    // incremental parser of "id/name" records arriving in chunks of arbitrary size:
+    //  - lines starting with '#' are comments - only at the beginning of the input
+    //  - blank lines are skipped
+    //  - a line is split at the first '/' (a line without it gives an empty record)
+    // the parser is a coroutine suspended at the chunk boundary - only an incomplete last line is buffered
+    class RecordParser
+    {
+    public:
+        struct Record
+        {
+            std::string_view id;
+            std::string_view name;
+
+            bool operator==(const Record&) const = default;
+        };
+
+    private:
+        struct promise_type;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+
+        struct Parse
+        {
+            using promise_type = RecordParser::promise_type;
+            CoroHandle coro_hndl;
+        };
+
+        struct promise_type
+        {
+            const Record* record = nullptr; // nullptr - the parser waits for more input
+            std::string_view input;
+            std::exception_ptr eptr;
+
+            Parse get_return_object() noexcept
+            {
+                return Parse{CoroHandle::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            std::suspend_always final_suspend() const noexcept { return {}; }
+
+            std::suspend_always yield_value(const Record& yielded) noexcept
+            {
+                record = &yielded;
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+                record = nullptr;
+            }
+
+            void unhandled_exception() noexcept
+            {
+                record = nullptr;
+                eptr = std::current_exception();
+            }
+        };
+
+        // co_await NextChunk{} - suspends until feed() or finish(); an empty chunk means the end of input
+        struct NextChunk
+        {
+            promise_type* promise = nullptr;
+
+            bool await_ready() const noexcept { return false; }
+
+            void await_suspend(CoroHandle coro_hndl) noexcept
+            {
+                promise = &coro_hndl.promise();
+                promise->record = nullptr;
+            }
+
+            std::string_view await_resume() const noexcept
+            {
+                return std::exchange(promise->input, {});
+            }
+        };
+
+    public:
+        // records parsed from the fed chunk - valid while the chunk is alive and until the next increment
+        class Records
+        {
+        public:
+            class iterator
+            {
+            public:
+                using value_type = Record;
+                using difference_type = std::ptrdiff_t;
+
+                iterator() = default;
+
+                explicit iterator(CoroHandle coro_hndl) noexcept
+                    : coro_hndl_{coro_hndl}
+                {
+                }
+
+                const Record& operator*() const noexcept
+                {
+                    return *coro_hndl_.promise().record;
+                }
+
+                iterator& operator++()
+                {
+                    resume(coro_hndl_);
+                    return *this;
+                }
+
+                void operator++(int)
+                {
+                    ++*this;
+                }
+
+                bool operator==(std::default_sentinel_t) const noexcept
+                {
+                    return coro_hndl_.promise().record == nullptr;
+                }
+
+            private:
+                CoroHandle coro_hndl_;
+            };
+
+            Records(CoroHandle coro_hndl, bool has_input) noexcept
+                : coro_hndl_{coro_hndl}
+                , has_input_{has_input}
+            {
+            }
+
+            iterator begin()
+            {
+                if (std::exchange(has_input_, false))
+                    resume(coro_hndl_);
+                return iterator{coro_hndl_};
+            }
+
+            std::default_sentinel_t end() const noexcept
+            {
+                return {};
+            }
+
+        private:
+            CoroHandle coro_hndl_;
+            bool has_input_;
+        };
+
+        RecordParser()
+            : coro_hndl_{parse().coro_hndl}
+        {
+            coro_hndl_.resume(); // runs until it waits for the first chunk
+        }
+
+        RecordParser(const RecordParser&) = delete;
+        RecordParser& operator=(const RecordParser&) = delete;
+
+        ~RecordParser()
+        {
+            coro_hndl_.destroy();
+        }
+
+        // records of the previous chunk must be consumed before the next one is fed
+        [[nodiscard]] Records feed(std::string_view chunk)
+        {
+            assert(!coro_hndl_.done() && coro_hndl_.promise().record == nullptr);
+
+            coro_hndl_.promise().input = chunk;
+            return Records{coro_hndl_, !chunk.empty()}; // an empty chunk would mean the end of input
+        }
+
+        // end of the stream - a last line without a trailing '\n' is still a record
+        [[nodiscard]] Records finish()
+        {
+            assert(!coro_hndl_.done() && coro_hndl_.promise().record == nullptr);
+
+            coro_hndl_.promise().input = {};
+            return Records{coro_hndl_, true};
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+
+        static void resume(CoroHandle coro_hndl)
+        {
+            if (coro_hndl.done())
+                return;
+
+            coro_hndl.resume();
+            if (auto eptr = std::exchange(coro_hndl.promise().eptr, nullptr))
+                std::rethrow_exception(eptr);
+        }
+
+        static std::optional<Record> parse_line(std::string_view line, bool& in_header)
+        {
+            if (in_header && line.starts_with('#'))
+                return std::nullopt;
+            in_header = false;
+
+            if (line.empty())
+                return std::nullopt;
+
+            const auto pos = line.find('/');
+            if (pos == std::string_view::npos)
+                return Record{};
+
+            return Record{line.substr(0, pos), line.substr(pos + 1)};
+        }
+
+        static Parse parse()
+        {
+            std::string carry; // line split between chunks
+            bool in_header = true;
+
+            while (true)
+            {
+                std::string_view chunk = co_await NextChunk{};
+                if (chunk.empty()) // end of input
+                    break;
+
+                while (!chunk.empty())
+                {
+                    const void* eol = std::memchr(chunk.data(), '\n', chunk.size());
+                    if (!eol)
+                    {
+                        carry.append(chunk); // suspend mid-line until the next chunk
+                        break;
+                    }
+
+                    const std::size_t line_length = static_cast<const char*>(eol) - chunk.data();
+                    std::string_view line = chunk.substr(0, line_length);
+                    if (!carry.empty())
+                        line = carry.append(line);
+                    chunk.remove_prefix(line_length + 1);
+
+                    if (auto record = parse_line(line, in_header))
+                        co_yield *record;
+
+                    carry.clear();
+                }
+            }
+
+            if (auto record = parse_line(carry, in_header))
+                co_yield *record;
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,516 @@
+#ifndef TASK_HPP
+#define TASK_HPP
+
+#include <coroutine>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <memory_resource>
+#include <semaphore>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace coro
+{
+    template <typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        // storage for a value or an exception produced by a coroutine
+        template <typename T>
+        class ResultStorage
+        {
+        public:
+            template <typename U>
+            void set_value(U&& value)
+            {
+                result_.template emplace<1>(std::forward<U>(value));
+            }
+
+            void set_exception(std::exception_ptr eptr) noexcept
+            {
+                result_.template emplace<2>(std::move(eptr));
+            }
+
+            T& get() &
+            {
+                rethrow_if_exception();
+                return std::get<1>(result_);
+            }
+
+            T&& get() &&
+            {
+                rethrow_if_exception();
+                return std::get<1>(std::move(result_));
+            }
+
+        private:
+            std::variant<std::monostate, T, std::exception_ptr> result_;
+
+            void rethrow_if_exception()
+            {
+                if (result_.index() == 2)
+                    std::rethrow_exception(std::get<2>(result_));
+            }
+        };
+
+        template <>
+        class ResultStorage<void>
+        {
+        public:
+            void set_value() noexcept { }
+
+            void set_exception(std::exception_ptr eptr) noexcept
+            {
+                eptr_ = std::move(eptr);
+            }
+
+            void get() const
+            {
+                if (eptr_)
+                    std::rethrow_exception(eptr_);
+            }
+
+        private:
+            std::exception_ptr eptr_;
+        };
+
+        // frames of coroutines declared as f(std::allocator_arg_t, std::pmr::memory_resource*, ...) are allocated from
+        // the given resource, the other ones with the global operator new; the resource (null for the global heap)
+        // is stored behind the frame so that operator delete can find it
+        class FrameAllocation
+        {
+        public:
+            static void* operator new(std::size_t size)
+            {
+                return store_resource(::operator new(total_size(size)), size, nullptr);
+            }
+
+            template <typename... TArgs>
+            static void* operator new(std::size_t size, std::allocator_arg_t, std::pmr::memory_resource* resource, TArgs&...)
+            {
+                return store_resource(resource->allocate(total_size(size), alignof(std::max_align_t)), size, resource);
+            }
+
+            // member coroutines - the object is the first argument
+            template <typename TThis, typename... TArgs>
+            static void* operator new(std::size_t size, TThis&, std::allocator_arg_t, std::pmr::memory_resource* resource, TArgs&...)
+            {
+                return store_resource(resource->allocate(total_size(size), alignof(std::max_align_t)), size, resource);
+            }
+
+            static void operator delete(void* frame, std::size_t size) noexcept
+            {
+                std::pmr::memory_resource* resource;
+                std::memcpy(&resource, static_cast<std::byte*>(frame) + resource_offset(size), sizeof(resource));
+
+                if (resource)
+                    resource->deallocate(frame, total_size(size), alignof(std::max_align_t));
+                else
+                    ::operator delete(frame, total_size(size));
+            }
+
+        private:
+            static constexpr std::size_t resource_offset(std::size_t frame_size) noexcept
+            {
+                return (frame_size + alignof(std::pmr::memory_resource*) - 1) & ~(alignof(std::pmr::memory_resource*) - 1);
+            }
+
+            static constexpr std::size_t total_size(std::size_t frame_size) noexcept
+            {
+                return resource_offset(frame_size) + sizeof(std::pmr::memory_resource*);
+            }
+
+            static void* store_resource(void* frame, std::size_t size, std::pmr::memory_resource* resource) noexcept
+            {
+                std::memcpy(static_cast<std::byte*>(frame) + resource_offset(size), &resource, sizeof(resource));
+                return frame;
+            }
+        };
+
+        class TaskPromiseBase : public FrameAllocation
+        {
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                template <typename TPromise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<TPromise> coro_hndl) noexcept
+                {
+                    return coro_hndl.promise().continuation(); // symmetric transfer to the awaiting coroutine
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+        public:
+            std::suspend_always initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            FinalAwaiter final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void set_continuation(std::coroutine_handle<> continuation) noexcept
+            {
+                continuation_ = continuation;
+            }
+
+            std::coroutine_handle<> continuation() const noexcept
+            {
+                return continuation_;
+            }
+
+            void set_stop_token(std::stop_token stop_tkn) noexcept
+            {
+                stop_token_ = std::move(stop_tkn);
+            }
+
+            const std::stop_token& stop_token() const noexcept
+            {
+                return stop_token_;
+            }
+
+        private:
+            std::coroutine_handle<> continuation_ = std::noop_coroutine();
+            std::stop_token stop_token_;
+        };
+
+        // awaited task inherits the stop token of the awaiting coroutine unless it has its own
+        template <typename TPromise, typename TAwaitingPromise>
+        void propagate_stop_token(TPromise& promise, std::coroutine_handle<TAwaitingPromise> awaiting_coro) noexcept
+        {
+            if constexpr (requires { awaiting_coro.promise().stop_token(); })
+            {
+                if (!promise.stop_token().stop_possible())
+                    promise.set_stop_token(awaiting_coro.promise().stop_token());
+            }
+        }
+
+        template <typename T>
+        class TaskPromise : public TaskPromiseBase, public ResultStorage<T>
+        {
+        public:
+            Task<T> get_return_object() noexcept;
+
+            template <typename U>
+                requires std::convertible_to<U&&, T>
+            void return_value(U&& value)
+            {
+                this->set_value(std::forward<U>(value));
+            }
+
+            void unhandled_exception() noexcept
+            {
+                this->set_exception(std::current_exception());
+            }
+        };
+
+        template <>
+        class TaskPromise<void> : public TaskPromiseBase, public ResultStorage<void>
+        {
+        public:
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept { }
+
+            void unhandled_exception() noexcept
+            {
+                this->set_exception(std::current_exception());
+            }
+        };
+    } // namespace detail
+
+    // lazily started coroutine - runs when awaited, resumes the awaiting coroutine on completion
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = detail::TaskPromise<T>;
+        using CoroHandle = std::coroutine_handle<promise_type>;
+        using value_type = T;
+
+    private:
+        struct AwaiterBase
+        {
+            CoroHandle coro_hndl;
+
+            bool await_ready() const noexcept
+            {
+                return !coro_hndl || coro_hndl.done();
+            }
+
+            template <typename TAwaitingPromise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<TAwaitingPromise> awaiting_coro) noexcept
+            {
+                detail::propagate_stop_token(coro_hndl.promise(), awaiting_coro);
+                coro_hndl.promise().set_continuation(awaiting_coro);
+                return coro_hndl;
+            }
+        };
+
+    public:
+        Task() noexcept = default;
+
+        explicit Task(CoroHandle coro_hndl) noexcept
+            : coro_hndl_{coro_hndl}
+        {
+        }
+
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+
+        Task(Task&& other) noexcept
+            : coro_hndl_{std::exchange(other.coro_hndl_, nullptr)}
+        {
+        }
+
+        Task& operator=(Task&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+                coro_hndl_ = std::exchange(other.coro_hndl_, nullptr);
+            }
+
+            return *this;
+        }
+
+        ~Task()
+        {
+            if (coro_hndl_)
+                coro_hndl_.destroy();
+        }
+
+        bool is_ready() const noexcept
+        {
+            return !coro_hndl_ || coro_hndl_.done();
+        }
+
+        // must be called before the task is started
+        void set_stop_token(std::stop_token stop_tkn) noexcept
+        {
+            coro_hndl_.promise().set_stop_token(std::move(stop_tkn));
+        }
+
+        auto operator co_await() & noexcept
+        {
+            struct Awaiter : AwaiterBase
+            {
+                decltype(auto) await_resume()
+                {
+                    return this->coro_hndl.promise().get();
+                }
+            };
+
+            return Awaiter{coro_hndl_};
+        }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter : AwaiterBase
+            {
+                decltype(auto) await_resume()
+                {
+                    return std::move(this->coro_hndl.promise()).get();
+                }
+            };
+
+            return Awaiter{coro_hndl_};
+        }
+
+        // waits for completion without fetching the result (exceptions are not rethrown)
+        auto when_ready() noexcept
+        {
+            struct Awaiter : AwaiterBase
+            {
+                void await_resume() const noexcept { }
+            };
+
+            return Awaiter{coro_hndl_};
+        }
+
+        decltype(auto) result() &
+        {
+            return coro_hndl_.promise().get();
+        }
+
+        decltype(auto) result() &&
+        {
+            return std::move(coro_hndl_.promise()).get();
+        }
+
+    private:
+        CoroHandle coro_hndl_;
+    };
+
+    template <typename T>
+    Task<T> detail::TaskPromise<T>::get_return_object() noexcept
+    {
+        return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+    }
+
+    inline Task<void> detail::TaskPromise<void>::get_return_object() noexcept
+    {
+        return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+    }
+
+    namespace detail
+    {
+        class SyncWaitTask
+        {
+        public:
+            struct promise_type
+            {
+                std::binary_semaphore* completed = nullptr;
+
+                SyncWaitTask get_return_object() noexcept
+                {
+                    return SyncWaitTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                auto final_suspend() const noexcept
+                {
+                    struct Notifier
+                    {
+                        bool await_ready() const noexcept { return false; }
+
+                        void await_suspend(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                        {
+                            coro_hndl.promise().completed->release();
+                        }
+
+                        void await_resume() const noexcept { }
+                    };
+
+                    return Notifier{};
+                }
+
+                void return_void() noexcept { }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate(); // exceptions are kept in the awaited task
+                }
+            };
+
+            explicit SyncWaitTask(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                : coro_hndl_{coro_hndl}
+            {
+            }
+
+            SyncWaitTask(const SyncWaitTask&) = delete;
+            SyncWaitTask& operator=(const SyncWaitTask&) = delete;
+
+            ~SyncWaitTask()
+            {
+                coro_hndl_.destroy();
+            }
+
+            void run_and_wait()
+            {
+                std::binary_semaphore completed{0};
+                coro_hndl_.promise().completed = &completed;
+                coro_hndl_.resume();
+                completed.acquire();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> coro_hndl_;
+        };
+    } // namespace detail
+
+    namespace detail
+    {
+        struct GetStopTokenAwaiter
+        {
+            std::stop_token stop_tkn;
+
+            bool await_ready() const noexcept { return false; }
+
+            template <typename TPromise>
+            bool await_suspend(std::coroutine_handle<TPromise> coro_hndl) noexcept
+            {
+                if constexpr (requires { coro_hndl.promise().stop_token(); })
+                    stop_tkn = coro_hndl.promise().stop_token();
+
+                return false; // never suspends
+            }
+
+            std::stop_token await_resume() noexcept
+            {
+                return std::move(stop_tkn);
+            }
+        };
+    } // namespace detail
+
+    // co_await get_stop_token() - returns the stop token of the current coroutine (empty if it has none)
+    inline detail::GetStopTokenAwaiter get_stop_token() noexcept
+    {
+        return {};
+    }
+
+    namespace detail
+    {
+        template <typename TAwaitable>
+        decltype(auto) get_awaiter(TAwaitable&& awaitable)
+        {
+            if constexpr (requires { std::forward<TAwaitable>(awaitable).operator co_await(); })
+                return std::forward<TAwaitable>(awaitable).operator co_await();
+            else
+                return std::forward<TAwaitable>(awaitable);
+        }
+
+        template <typename TAwaitable>
+        using AwaitResult = decltype(get_awaiter(std::declval<TAwaitable>()).await_resume());
+
+        template <typename T>
+        constexpr bool is_task_v = false;
+
+        template <typename T>
+        constexpr bool is_task_v<Task<T>> = true;
+    } // namespace detail
+
+    // blocks the calling thread until the task completes
+    template <typename T>
+    decltype(auto) sync_wait(Task<T>&& task)
+    {
+        auto waiter = [](Task<T>& task) -> detail::SyncWaitTask { co_await task.when_ready(); }(task);
+        waiter.run_and_wait();
+
+        if constexpr (std::is_void_v<T>)
+            task.result();
+        else
+        {
+            T result = std::move(task).result(); // not T{...} - that would prefer initializer_list constructors
+            return result;
+        }
+    }
+
+    // blocks the calling thread until the awaitable completes
+    template <typename TAwaitable>
+        requires(!detail::is_task_v<std::remove_cvref_t<TAwaitable>>)
+    decltype(auto) sync_wait(TAwaitable&& awaitable)
+    {
+        using TResult = std::remove_cvref_t<detail::AwaitResult<TAwaitable>>;
+
+        return sync_wait([](TAwaitable& awaitable) -> Task<TResult> {
+            co_return co_await std::forward<TAwaitable>(awaitable);
+        }(awaitable));
+    }
+} // namespace coro
+
+#endif
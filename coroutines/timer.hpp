@@ -0,0 +1,201 @@
+#ifndef TIMER_HPP
+#define TIMER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace coro
+{
+    // single thread timer - sleeping coroutines are resumed on the timer thread
+    class Timer
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+    private:
+        class SleepAwaiter;
+        using Timers = std::multimap<Clock::time_point, SleepAwaiter*>;
+
+        class SleepAwaiter
+        {
+            struct OnStop
+            {
+                SleepAwaiter* awaiter;
+
+                void operator()() const noexcept
+                {
+                    if (awaiter->timer_.deregister(*awaiter))
+                        awaiter->complete(true);
+                }
+            };
+
+        public:
+            SleepAwaiter(Timer& timer, Clock::time_point deadline, std::stop_token stop_tkn) noexcept
+                : timer_{timer}
+                , deadline_{deadline}
+                , stop_tkn_{std::move(stop_tkn)}
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return stop_tkn_.stop_requested() || deadline_ <= Clock::now();
+            }
+
+            bool await_suspend(std::coroutine_handle<> coro_hndl)
+            {
+                coro_hndl_ = coro_hndl;
+                suspended_ = true;
+                timer_.add(*this);
+                if (stop_tkn_.stop_possible())
+                    on_stop_.emplace(stop_tkn_, OnStop{this});
+
+                // false if the timer has fired or the sleep was cancelled in the meantime
+                return !handshake_.exchange(true, std::memory_order_acq_rel);
+            }
+
+            // returns false if the sleep was cancelled
+            bool await_resume() noexcept
+            {
+                if (!suspended_)
+                    return !stop_tkn_.stop_requested();
+
+                on_stop_.reset();
+                return !cancelled_;
+            }
+
+        private:
+            friend class Timer;
+
+            Timer& timer_;
+            Clock::time_point deadline_;
+            std::stop_token stop_tkn_;
+            std::coroutine_handle<> coro_hndl_;
+            std::optional<std::stop_callback<OnStop>> on_stop_;
+            std::optional<Timers::iterator> pos_; // guarded by the timer's mutex
+            std::atomic<bool> handshake_{false};
+            bool suspended_ = false;
+            bool cancelled_ = false;
+
+            // called exactly once - by the one that removed the awaiter from the timer
+            void complete(bool is_cancelled) noexcept
+            {
+                cancelled_ = is_cancelled;
+                if (handshake_.exchange(true, std::memory_order_acq_rel))
+                    coro_hndl_.resume();
+            }
+        };
+
+    public:
+        Timer()
+            : thread_{[this](std::stop_token stop_tkn) { run(stop_tkn); }}
+        {
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        // pending sleeps are resumed as cancelled when the timer is destroyed
+        ~Timer()
+        {
+            thread_.request_stop();
+            thread_.join();
+        }
+
+        [[nodiscard]] SleepAwaiter sleep_until(Clock::time_point deadline, std::stop_token stop_tkn = {}) noexcept
+        {
+            return SleepAwaiter{*this, deadline, std::move(stop_tkn)};
+        }
+
+        [[nodiscard]] SleepAwaiter sleep_for(Clock::duration duration, std::stop_token stop_tkn = {}) noexcept
+        {
+            return sleep_until(Clock::now() + duration, std::move(stop_tkn));
+        }
+
+        std::size_t pending() const
+        {
+            std::lock_guard lk{mtx_timers_};
+            return timers_.size();
+        }
+
+    private:
+        mutable std::mutex mtx_timers_;
+        std::condition_variable_any cv_timers_;
+        Timers timers_;
+        bool timers_changed_ = false;
+        std::jthread thread_;
+
+        void add(SleepAwaiter& awaiter)
+        {
+            {
+                std::lock_guard lk{mtx_timers_};
+                awaiter.pos_ = timers_.emplace(awaiter.deadline_, &awaiter);
+                timers_changed_ = true;
+            }
+            cv_timers_.notify_one();
+        }
+
+        bool deregister(SleepAwaiter& awaiter)
+        {
+            std::lock_guard lk{mtx_timers_};
+            if (!awaiter.pos_)
+                return false;
+
+            timers_.erase(*awaiter.pos_);
+            awaiter.pos_.reset();
+            return true;
+        }
+
+        std::vector<SleepAwaiter*> take_expired(Clock::time_point now)
+        {
+            std::vector<SleepAwaiter*> expired;
+            auto last = timers_.upper_bound(now);
+            for (auto it = timers_.begin(); it != last; ++it)
+            {
+                it->second->pos_.reset();
+                expired.push_back(it->second);
+            }
+            timers_.erase(timers_.begin(), last);
+
+            return expired;
+        }
+
+        void run(std::stop_token stop_tkn)
+        {
+            std::unique_lock lk{mtx_timers_};
+            while (!stop_tkn.stop_requested())
+            {
+                timers_changed_ = false;
+                if (timers_.empty())
+                    cv_timers_.wait(lk, stop_tkn, [this] { return timers_changed_; });
+                else
+                {
+                    const auto next_deadline = timers_.begin()->first; // the node may be erased while waiting
+                    cv_timers_.wait_until(lk, stop_tkn, next_deadline, [this] { return timers_changed_; });
+                }
+
+                auto expired = take_expired(Clock::now());
+                lk.unlock();
+                for (SleepAwaiter* awaiter : expired)
+                    awaiter->complete(false);
+                lk.lock();
+            }
+
+            auto cancelled = take_expired(Clock::time_point::max());
+            lk.unlock();
+            for (SleepAwaiter* awaiter : cancelled)
+                awaiter->complete(true);
+        }
+    };
+} // namespace coro
+
+#endif
@@ -0,0 +1,204 @@
+#include "task.hpp"
+#include "when_all.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <any>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    coro::Task<int> square(int x)
+    {
+        co_return x * x;
+    }
+
+    coro::Task<int> square_on(helpers::ThreadPool& pool, int x)
+    {
+        co_await pool.schedule();
+        co_return x * x;
+    }
+
+    coro::Task<std::string> text_on(helpers::ThreadPool& pool, std::string txt)
+    {
+        co_await pool.schedule();
+        co_return txt;
+    }
+
+    coro::Task<> nothing_on(helpers::ThreadPool& pool, std::atomic<int>& counter)
+    {
+        co_await pool.schedule();
+        ++counter;
+    }
+
+    coro::Task<int> failing_on(helpers::ThreadPool& pool)
+    {
+        co_await pool.schedule();
+        throw std::runtime_error("ERROR#13");
+    }
+
+    coro::Task<int> add_squares(int a, int b)
+    {
+        co_return co_await square(a) + co_await square(b);
+    }
+
+    coro::Task<std::vector<std::any>> make_anys()
+    {
+        co_return std::vector<std::any>{1, 2, 3};
+    }
+} // namespace
+
+TEST_CASE("task - sync_wait")
+{
+    REQUIRE(coro::sync_wait(add_squares(3, 4)) == 25);
+    REQUIRE(coro::sync_wait(make_anys()).size() == 3); // the vector itself, not a vector holding it
+}
+
+TEST_CASE("when_all")
+{
+    helpers::ThreadPool pool{4};
+
+    SECTION("variadic - results in a tuple")
+    {
+        std::atomic<int> counter{};
+
+        auto [x, txt, done] = coro::sync_wait(coro::when_all(square_on(pool, 4), text_on(pool, "text"), nothing_on(pool, counter)));
+
+        REQUIRE(x == 16);
+        REQUIRE(txt == "text"s);
+        REQUIRE(counter == 1);
+    }
+
+    SECTION("range of tasks - results in order")
+    {
+        std::vector<coro::Task<int>> tasks;
+        for (int i = 0; i < 100; ++i)
+            tasks.push_back(square_on(pool, i));
+
+        std::vector<int> results = coro::sync_wait(coro::when_all(std::move(tasks)));
+
+        REQUIRE(results.size() == 100);
+        for (int i = 0; i < 100; ++i)
+            REQUIRE(results[i] == i * i);
+    }
+
+    SECTION("range of void tasks")
+    {
+        std::atomic<int> counter{};
+
+        std::vector<coro::Task<>> tasks;
+        for (int i = 0; i < 100; ++i)
+            tasks.push_back(nothing_on(pool, counter));
+
+        coro::sync_wait(coro::when_all(std::move(tasks)));
+
+        REQUIRE(counter == 100);
+    }
+
+    SECTION("tasks completed synchronously")
+    {
+        auto [a, b] = coro::sync_wait(coro::when_all(square(2), square(3)));
+
+        REQUIRE(a == 4);
+        REQUIRE(b == 9);
+    }
+
+    SECTION("exception is propagated")
+    {
+        REQUIRE_THROWS_AS(coro::sync_wait(coro::when_all(square_on(pool, 2), failing_on(pool))), std::runtime_error);
+    }
+}
+
+TEST_CASE("when_any")
+{
+    helpers::ThreadPool pool{4};
+
+    SECTION("first completed task wins")
+    {
+        auto [index, result] = coro::sync_wait(coro::when_any(square(2), square_on(pool, 3), square_on(pool, 4)));
+
+        REQUIRE(index == 0);
+        REQUIRE(result == 4);
+    }
+
+    SECTION("result of a task resumed on pool")
+    {
+        std::vector<coro::Task<int>> tasks;
+        for (int i = 0; i < 10; ++i)
+            tasks.push_back(square_on(pool, i));
+
+        auto [index, result] = coro::sync_wait(coro::when_any(std::move(tasks)));
+
+        REQUIRE(result == static_cast<int>(index * index));
+    }
+
+    SECTION("exception of the winner is propagated")
+    {
+        REQUIRE_THROWS_AS(coro::sync_wait(coro::when_any(failing_on(pool))), std::runtime_error);
+    }
+
+    SECTION("empty vector is rejected")
+    {
+        REQUIRE_THROWS_AS(coro::sync_wait(coro::when_any(std::vector<coro::Task<int>>{})), std::invalid_argument);
+    }
+}
+
+TEST_CASE("when_all - fan-out of 1000 tasks - tail latency", "[.][benchmark]")
+{
+    constexpr int fan_out = 1'000;
+    constexpr int samples = 500;
+
+    helpers::ThreadPool pool;
+
+    auto fan_out_tasks = [&pool] {
+        std::vector<coro::Task<int>> tasks;
+        tasks.reserve(fan_out);
+        for (int i = 0; i < fan_out; ++i)
+            tasks.push_back(square_on(pool, i));
+        return tasks;
+    };
+
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(samples);
+
+    for (int i = 0; i < samples; ++i)
+    {
+        auto tasks = fan_out_tasks();
+
+        auto start = std::chrono::steady_clock::now();
+        auto results = coro::sync_wait(coro::when_all(std::move(tasks)));
+        latencies.push_back(std::chrono::steady_clock::now() - start);
+
+        REQUIRE(results.size() == fan_out);
+    }
+
+    std::ranges::sort(latencies);
+    auto percentile = [&latencies](double p) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(latencies[static_cast<size_t>(p * (latencies.size() - 1))]).count();
+    };
+
+    std::cout << "when_all(" << fan_out << " tasks) on " << pool.size() << " threads: "
+              << "p50 = " << percentile(0.5) << "us, "
+              << "p99 = " << percentile(0.99) << "us, "
+              << "max = " << percentile(1.0) << "us\n";
+
+    BENCHMARK_ADVANCED("when_all - 1000 tasks")(Catch::Benchmark::Chronometer meter)
+    {
+        std::vector<std::vector<coro::Task<int>>> inputs(meter.runs());
+        std::ranges::generate(inputs, fan_out_tasks);
+
+        meter.measure([&](int i) { return coro::sync_wait(coro::when_all(std::move(inputs[i]))).size(); });
+    };
+}
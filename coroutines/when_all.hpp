@@ -0,0 +1,437 @@
+#ifndef WHEN_ALL_HPP
+#define WHEN_ALL_HPP
+
+#include "task.hpp"
+
+#include <atomic>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <stop_token>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace coro
+{
+    namespace detail
+    {
+        template <typename T>
+        using NonVoid = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+        // N + 1 countdown: every child and the awaiting coroutine decrement once - the last one resumes the awaiter
+        class WhenAllCounter
+        {
+        public:
+            explicit WhenAllCounter(std::size_t count) noexcept
+                : count_{count + 1}
+            {
+            }
+
+            bool try_await(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                awaiting_coro_ = awaiting_coro;
+                return count_.fetch_sub(1, std::memory_order_acq_rel) > 1;
+            }
+
+            std::coroutine_handle<> notify_completed() noexcept
+            {
+                if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    return awaiting_coro_;
+
+                return std::noop_coroutine();
+            }
+
+        private:
+            std::atomic<std::size_t> count_;
+            std::coroutine_handle<> awaiting_coro_;
+        };
+
+        template <typename T>
+        class WhenAllChild
+        {
+        public:
+            struct promise_type : ResultStorage<T>
+            {
+                WhenAllCounter* counter = nullptr;
+                std::stop_token stop_tkn;
+
+                const std::stop_token& stop_token() const noexcept
+                {
+                    return stop_tkn;
+                }
+
+                WhenAllChild get_return_object() noexcept
+                {
+                    return WhenAllChild{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                auto final_suspend() const noexcept
+                {
+                    struct Notifier
+                    {
+                        bool await_ready() const noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                        {
+                            return coro_hndl.promise().counter->notify_completed();
+                        }
+
+                        void await_resume() const noexcept { }
+                    };
+
+                    return Notifier{};
+                }
+
+                template <typename U>
+                void return_value(U&& value)
+                {
+                    this->set_value(std::forward<U>(value));
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    this->set_exception(std::current_exception());
+                }
+            };
+
+            explicit WhenAllChild(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                : coro_hndl_{coro_hndl}
+            {
+            }
+
+            WhenAllChild(WhenAllChild&& other) noexcept
+                : coro_hndl_{std::exchange(other.coro_hndl_, nullptr)}
+            {
+            }
+
+            WhenAllChild& operator=(WhenAllChild&&) = delete;
+
+            ~WhenAllChild()
+            {
+                if (coro_hndl_)
+                    coro_hndl_.destroy();
+            }
+
+            void start(WhenAllCounter& counter, const std::stop_token& stop_tkn) noexcept
+            {
+                coro_hndl_.promise().counter = &counter;
+                coro_hndl_.promise().stop_tkn = stop_tkn;
+                coro_hndl_.resume();
+            }
+
+            T result() &&
+            {
+                return std::move(coro_hndl_.promise()).get();
+            }
+
+        private:
+            std::coroutine_handle<promise_type> coro_hndl_;
+        };
+
+        template <typename T>
+        WhenAllChild<NonVoid<T>> make_when_all_child(Task<T> task)
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(task);
+                co_return std::monostate{};
+            }
+            else
+                co_return co_await std::move(task);
+        }
+
+        template <typename TChildren>
+        struct WhenAllAwaiter
+        {
+            TChildren& children;
+            WhenAllCounter& counter;
+            std::stop_token stop_tkn;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                if constexpr (requires { children.begin(); })
+                {
+                    for (auto& child : children)
+                        child.start(counter, stop_tkn);
+                }
+                else
+                {
+                    std::apply([this](auto&... child) { (child.start(counter, stop_tkn), ...); }, children);
+                }
+
+                return counter.try_await(awaiting_coro);
+            }
+
+            void await_resume() const noexcept { }
+        };
+    } // namespace detail
+
+    // completes when all tasks complete - results are moved into a tuple (void results as std::monostate)
+    template <typename... Ts>
+    Task<std::tuple<detail::NonVoid<Ts>...>> when_all(Task<Ts>... tasks)
+    {
+        auto children = std::make_tuple(detail::make_when_all_child(std::move(tasks))...);
+        detail::WhenAllCounter counter{sizeof...(Ts)};
+
+        std::stop_token stop_tkn = co_await get_stop_token();
+        co_await detail::WhenAllAwaiter{children, counter, std::move(stop_tkn)};
+
+        co_return std::apply(
+            [](auto&... child) { return std::tuple<detail::NonVoid<Ts>...>{std::move(child).result()...}; },
+            children);
+    }
+
+    template <typename T>
+    using WhenAllRangeResult = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+    // completes when all tasks from the vector complete - results are returned in the order of the tasks
+    template <typename T>
+    Task<WhenAllRangeResult<T>> when_all(std::vector<Task<T>> tasks)
+    {
+        std::vector<detail::WhenAllChild<detail::NonVoid<T>>> children;
+        children.reserve(tasks.size());
+        for (auto& task : tasks)
+            children.push_back(detail::make_when_all_child(std::move(task)));
+
+        detail::WhenAllCounter counter{children.size()};
+
+        std::stop_token stop_tkn = co_await get_stop_token();
+        co_await detail::WhenAllAwaiter{children, counter, std::move(stop_tkn)};
+
+        if constexpr (std::is_void_v<T>)
+        {
+            for (auto& child : children)
+                std::move(child).result();
+        }
+        else
+        {
+            std::vector<T> results;
+            results.reserve(children.size());
+            for (auto& child : children)
+                results.push_back(std::move(child).result());
+
+            co_return results;
+        }
+    }
+
+    namespace detail
+    {
+        // shared between when_any and its children - losers finish in the background and only drop the reference
+        // single atomic word: (winner_index + 1) << 1 | awaiting_flag
+        template <typename T>
+        class WhenAnyState
+        {
+            static constexpr std::size_t awaiting_flag = 1;
+
+        public:
+            explicit WhenAnyState(std::size_t count)
+                : results_(count)
+            {
+            }
+
+            ResultStorage<T>& slot(std::size_t index) noexcept
+            {
+                return results_[index];
+            }
+
+            std::stop_token stop_token() const noexcept
+            {
+                return stop_source_.get_token();
+            }
+
+            void request_stop() noexcept
+            {
+                stop_source_.request_stop();
+            }
+
+            // called after the child has filled its slot - returns the coroutine the child transfers to at its end:
+            // the awaiting coroutine if this child won and when_any has already suspended, otherwise a no-op
+            std::coroutine_handle<> try_complete(std::size_t index) noexcept
+            {
+                std::size_t state = state_.load(std::memory_order_acquire);
+                while ((state >> 1) == 0)
+                {
+                    if (state_.compare_exchange_weak(state, state | ((index + 1) << 1), std::memory_order_acq_rel))
+                    {
+                        stop_source_.request_stop(); // losers are cancelled before the awaiting coroutine resumes
+
+                        if (state & awaiting_flag)
+                            return awaiting_coro_;
+                        break;
+                    }
+                }
+
+                return std::noop_coroutine();
+            }
+
+            bool try_await(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                awaiting_coro_ = awaiting_coro;
+                return (state_.fetch_or(awaiting_flag, std::memory_order_acq_rel) >> 1) == 0;
+            }
+
+            std::size_t index() const noexcept
+            {
+                return (state_.load(std::memory_order_acquire) >> 1) - 1;
+            }
+
+            ResultStorage<T>& result() noexcept
+            {
+                return results_[index()];
+            }
+
+        private:
+            std::atomic<std::size_t> state_{0};
+            std::coroutine_handle<> awaiting_coro_;
+            std::vector<ResultStorage<T>> results_;
+            std::stop_source stop_source_;
+        };
+
+        // self-destroying coroutine started by when_any - co_returns the coroutine to transfer to when it ends
+        struct WhenAnyChild
+        {
+            struct promise_type
+            {
+                std::coroutine_handle<> continuation;
+
+                WhenAnyChild get_return_object() noexcept
+                {
+                    return WhenAnyChild{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept
+                {
+                    return {};
+                }
+
+                auto final_suspend() const noexcept
+                {
+                    struct DestroyAndTransfer
+                    {
+                        bool await_ready() const noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> coro_hndl) noexcept
+                        {
+                            const std::coroutine_handle<> continuation = coro_hndl.promise().continuation;
+                            coro_hndl.destroy();
+                            return continuation; // symmetric transfer to the awaiting coroutine
+                        }
+
+                        void await_resume() const noexcept { }
+                    };
+
+                    return DestroyAndTransfer{};
+                }
+
+                void return_value(std::coroutine_handle<> next) noexcept
+                {
+                    continuation = next;
+                }
+
+                void unhandled_exception() noexcept
+                {
+                    std::terminate();
+                }
+            };
+
+            std::coroutine_handle<promise_type> coro_hndl;
+        };
+
+        template <typename T>
+        WhenAnyChild make_when_any_child(Task<T> task, std::shared_ptr<WhenAnyState<T>> state, std::size_t index)
+        {
+            ResultStorage<T>& result = state->slot(index);
+            try
+            {
+                if constexpr (std::is_void_v<T>)
+                {
+                    co_await std::move(task);
+                    result.set_value();
+                }
+                else
+                    result.set_value(co_await std::move(task));
+            }
+            catch (...)
+            {
+                result.set_exception(std::current_exception());
+            }
+
+            co_return state->try_complete(index);
+        }
+
+        template <typename T>
+        struct WhenAnyAwaiter
+        {
+            std::vector<Task<T>>& tasks;
+            std::shared_ptr<WhenAnyState<T>>& state;
+
+            bool await_ready() const noexcept { return false; }
+
+            bool await_suspend(std::coroutine_handle<> awaiting_coro) noexcept
+            {
+                for (std::size_t i = 0; i < tasks.size(); ++i)
+                {
+                    tasks[i].set_stop_token(state->stop_token());
+                    make_when_any_child(std::move(tasks[i]), state, i).coro_hndl.resume();
+                }
+
+                return state->try_await(awaiting_coro);
+            }
+
+            void await_resume() const noexcept { }
+        };
+    } // namespace detail
+
+    template <typename T>
+    using WhenAnyResult = std::conditional_t<std::is_void_v<T>, std::size_t, std::pair<std::size_t, T>>;
+
+    // completes when the first task completes - returns its index (and result)
+    // remaining tasks are asked to stop through their stop token and run to completion detached
+    // throws std::invalid_argument for an empty vector - there would be no winner to wait for
+    template <typename T>
+    Task<WhenAnyResult<T>> when_any(std::vector<Task<T>> tasks)
+    {
+        if (tasks.empty())
+            throw std::invalid_argument{"when_any: no tasks"};
+
+        auto state = std::make_shared<detail::WhenAnyState<T>>(tasks.size());
+        std::stop_token stop_tkn = co_await get_stop_token();
+        std::stop_callback forward_stop{std::move(stop_tkn), [&state] { state->request_stop(); }};
+
+        co_await detail::WhenAnyAwaiter<T>{tasks, state};
+
+        if constexpr (std::is_void_v<T>)
+        {
+            state->result().get();
+            co_return state->index();
+        }
+        else
+            co_return std::pair<std::size_t, T>{state->index(), std::move(state->result()).get()};
+    }
+
+    template <typename T, typename... Ts>
+        requires(std::same_as<T, Ts> && ...)
+    Task<WhenAnyResult<T>> when_any(Task<T> first, Task<Ts>... rest)
+    {
+        std::vector<Task<T>> tasks;
+        tasks.reserve(1 + sizeof...(Ts));
+        tasks.push_back(std::move(first));
+        (tasks.push_back(std::move(rest)), ...);
+
+        return when_any(std::move(tasks));
+    }
+} // namespace coro
+
+#endif
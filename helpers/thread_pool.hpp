@@ -0,0 +1,177 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace helpers
+{
+    class ThreadPool
+    {
+    public:
+        using Job = std::function<void()>;
+
+        explicit ThreadPool(std::size_t size = std::max(1u, std::thread::hardware_concurrency()))
+        {
+            threads_.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+                threads_.emplace_back([this](std::stop_token stop_tkn) { run(stop_tkn); });
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // jthreads request stop & join - queued jobs are drained before workers exit
+        ~ThreadPool() = default;
+
+        std::size_t size() const noexcept
+        {
+            return threads_.size();
+        }
+
+        // true on the threads of this pool - work that blocks waiting for other jobs of the pool must not run there
+        bool is_worker() const noexcept
+        {
+            return current_pool_ == this;
+        }
+
+        template <std::invocable F>
+        void submit(F&& job)
+        {
+            {
+                std::lock_guard lk{mtx_jobs_};
+                jobs_.emplace_back(std::forward<F>(job));
+            }
+            cv_jobs_.notify_one();
+        }
+
+        // co_await pool.schedule() - resumes the coroutine on one of the workers
+        auto schedule() noexcept
+        {
+            struct ScheduleAwaiter
+            {
+                ThreadPool& pool;
+
+                bool await_ready() const noexcept { return false; }
+
+                void await_suspend(std::coroutine_handle<> coro_hndl)
+                {
+                    pool.submit([coro_hndl] { coro_hndl.resume(); });
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+            return ScheduleAwaiter{*this};
+        }
+
+        // co_await pool.schedule(stop_tkn) - returns false if stop was requested before a worker picked the coroutine up;
+        // a cancelled coroutine is resumed immediately on the thread that requested stop
+        auto schedule(std::stop_token stop_tkn)
+        {
+            struct State
+            {
+                std::coroutine_handle<> coro_hndl;
+                std::atomic<bool> claimed{false};   // by a worker or by the stop callback
+                std::atomic<bool> handshake{false}; // second of (await_suspend finished, claimed) resumes
+                bool cancelled = false;
+
+                void complete(bool is_cancelled) noexcept
+                {
+                    if (claimed.exchange(true, std::memory_order_acq_rel))
+                        return;
+
+                    cancelled = is_cancelled;
+                    if (handshake.exchange(true, std::memory_order_acq_rel))
+                        coro_hndl.resume();
+                }
+            };
+
+            struct OnStop
+            {
+                std::shared_ptr<State> state;
+
+                void operator()() const noexcept
+                {
+                    state->complete(true);
+                }
+            };
+
+            struct CancellableScheduleAwaiter
+            {
+                ThreadPool& pool;
+                std::stop_token stop_tkn;
+                std::shared_ptr<State> state = std::make_shared<State>();
+                std::optional<std::stop_callback<OnStop>> on_stop{};
+
+                bool await_ready() const noexcept
+                {
+                    return stop_tkn.stop_requested();
+                }
+
+                bool await_suspend(std::coroutine_handle<> coro_hndl)
+                {
+                    std::shared_ptr<State> st = state; // the awaiter may be gone as soon as the job is queued
+                    st->coro_hndl = coro_hndl;
+                    on_stop.emplace(stop_tkn, OnStop{st});
+                    pool.submit([st] { st->complete(false); });
+
+                    return !st->handshake.exchange(true, std::memory_order_acq_rel);
+                }
+
+                bool await_resume() noexcept
+                {
+                    if (!on_stop) // stop was requested before suspension
+                        return false;
+
+                    on_stop.reset();
+                    return !state->cancelled;
+                }
+            };
+
+            return CancellableScheduleAwaiter{*this, std::move(stop_tkn)};
+        }
+
+    private:
+        static inline thread_local const ThreadPool* current_pool_ = nullptr;
+
+        std::mutex mtx_jobs_;
+        std::condition_variable_any cv_jobs_;
+        std::deque<Job> jobs_;
+        std::vector<std::jthread> threads_; // must be the last member - joined before the queue is destroyed
+
+        void run(std::stop_token stop_tkn)
+        {
+            current_pool_ = this;
+
+            while (true)
+            {
+                Job job;
+                {
+                    std::unique_lock lk{mtx_jobs_};
+                    if (!cv_jobs_.wait(lk, stop_tkn, [this] { return !jobs_.empty(); }))
+                        return;
+
+                    job = std::move(jobs_.front());
+                    jobs_.pop_front();
+                }
+
+                job();
+            }
+        }
+    };
+} // namespace helpers
+
+#endif
@@ -0,0 +1,118 @@
+#include "batched.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace
+{
+    auto square = [](long n) { return n * n; };
+    auto is_even = [](long x) { return x % 2 == 0; };
+
+    struct Boxed // not default-constructible
+    {
+        explicit Boxed(long value)
+            : value{value}
+        {
+        }
+
+        long value;
+    };
+
+    template <typename R>
+    auto scalar(R&& rng)
+    {
+        std::vector<std::ranges::range_value_t<R>> result;
+        std::ranges::copy(rng, std::back_inserter(result));
+        return result;
+    }
+} // namespace
+
+TEST_CASE("batched evaluation of transform/filter chains")
+{
+    SECTION("the same results as views for sizes around the block size")
+    {
+        for (long size : {0L, 1L, 255L, 256L, 257L, 1000L, 10'000L})
+        {
+            auto source = std::views::iota(0L, size);
+
+            const auto expected = scalar(source | std::views::transform(square) | std::views::filter(is_even));
+            REQUIRE(rng::batch::to_vector(source, rng::batch::transform(square) | rng::batch::filter(is_even)) == expected);
+        }
+    }
+
+    SECTION("filter first, several stages and a change of the element type")
+    {
+        std::vector<int> source(1000);
+        std::iota(source.begin(), source.end(), -500);
+
+        auto to_text = [](long n) { return std::to_string(n); };
+        auto is_div_by_3 = [](long n) { return n % 3 == 0; };
+
+        const auto expected = scalar(source
+            | std::views::filter(is_even)
+            | std::views::transform(square)
+            | std::views::filter(is_div_by_3)
+            | std::views::transform(to_text));
+
+        auto result = rng::batch::to_vector<64>(source,
+            rng::batch::filter(is_even) | rng::batch::transform(square) | rng::batch::filter(is_div_by_3) | rng::batch::transform(to_text));
+
+        static_assert(std::is_same_v<decltype(result), std::vector<std::string>>);
+        REQUIRE(result == expected);
+    }
+
+    SECTION("input ranges and output iterators")
+    {
+        const std::list<long> source = {1, 2, 3, 4, 5, 6};
+
+        std::list<long> result;
+        rng::batch::copy<4>(source, rng::batch::filter(is_even) | rng::batch::transform(square), std::back_inserter(result));
+
+        REQUIRE(result == std::list<long>{4, 16, 36});
+    }
+
+    SECTION("element types that are not default-constructible or not trivial")
+    {
+        auto box = [](long n) { return Boxed{n}; };
+        auto unbox = [](const Boxed& b) { return b.value; };
+        auto is_even_box = [](const Boxed& b) { return b.value % 2 == 0; };
+
+        auto boxed = rng::batch::to_vector<16>(std::views::iota(0L, 100L),
+            rng::batch::transform(box) | rng::batch::filter(is_even_box) | rng::batch::transform(unbox));
+        REQUIRE(boxed == scalar(std::views::iota(0L, 100L) | std::views::filter(is_even)));
+
+        const std::list<std::string> words = {"a", "bb", "ccc", "dddd", "eeeee"};
+        auto is_long = [](const std::string& word) { return word.size() > 2; };
+
+        auto long_words = rng::batch::to_vector<2>(words, rng::batch::filter(is_long));
+        REQUIRE(long_words == std::vector<std::string>{"ccc", "dddd", "eeeee"});
+    }
+}
+
+TEST_CASE("batched evaluation vs views", "[.][benchmark]")
+{
+    const auto source = helpers::create_numeric_dataset<65'536>(42, -10'000, 10'000); // fits in L2 - measures the kernels, not memory
+    std::vector<int> destination(source.size());
+
+    auto square_int = [](int n) { return n * n; };
+    auto is_even_int = [](int x) { return x % 2 == 0; };
+
+    BENCHMARK("views - transform | filter")
+    {
+        return std::ranges::copy(source | std::views::transform(square_int) | std::views::filter(is_even_int), destination.begin()).out;
+    };
+
+    BENCHMARK("batched - transform | filter")
+    {
+        return rng::batch::copy(source, rng::batch::transform(square_int) | rng::batch::filter(is_even_int), destination.begin());
+    };
+}
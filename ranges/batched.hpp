@@ -0,0 +1,302 @@
+#ifndef BATCHED_HPP
+#define BATCHED_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+// batched evaluation of transform/filter pipelines - elements are pulled from the source in fixed-size blocks
+// and every stage runs as a tight loop over the whole block, which compilers can vectorize:
+//   transform - out[i] = f(in[i])
+//   filter    - mask[i] = pred(in[i]) and a branchless compress: out[k] = in[i]; k += mask[i]
+//               (vcompress for 4/8-byte elements when built with AVX-512)
+// results are the same as for std::views::transform/filter as long as the kernels are pure
+// (a transform followed by a filter is invoked once per element instead of twice for the kept ones)
+namespace rng::batch
+{
+    template <typename F>
+    struct TransformStage
+    {
+        F func;
+    };
+
+    template <typename F>
+    struct FilterStage
+    {
+        F pred;
+    };
+
+    template <typename... TStages>
+    struct Pipeline
+    {
+        std::tuple<TStages...> stages;
+    };
+
+    template <typename F>
+    Pipeline<TransformStage<F>> transform(F func)
+    {
+        return {{TransformStage<F>{std::move(func)}}};
+    }
+
+    template <typename F>
+    Pipeline<FilterStage<F>> filter(F pred)
+    {
+        return {{FilterStage<F>{std::move(pred)}}};
+    }
+
+    template <typename... TLeft, typename... TRight>
+    Pipeline<TLeft..., TRight...> operator|(Pipeline<TLeft...> left, Pipeline<TRight...> right)
+    {
+        return {std::tuple_cat(std::move(left.stages), std::move(right.stages))};
+    }
+
+    namespace detail
+    {
+        // element type after all stages - transforms change it, filters keep it
+        template <typename T, typename... TStages>
+        struct Output
+        {
+            using type = T;
+        };
+
+        template <typename T, typename F, typename... TRest>
+        struct Output<T, TransformStage<F>, TRest...> : Output<std::remove_cvref_t<std::invoke_result_t<F&, T&>>, TRest...>
+        {
+        };
+
+        template <typename T, typename F, typename... TRest>
+        struct Output<T, FilterStage<F>, TRest...> : Output<T, TRest...>
+        {
+        };
+
+        template <typename T, typename... TStages>
+        using output_t = typename Output<T, TStages...>::type;
+
+        // storage of a stage for up to BlockSize elements - they are constructed only when appended,
+        // so element types need not be default-constructible and a block of strings costs only the strings it holds
+        template <typename T, std::size_t BlockSize>
+        class Block
+        {
+        public:
+            Block() = default;
+            Block(const Block&) = delete;
+            Block& operator=(const Block&) = delete;
+
+            ~Block()
+            {
+                clear();
+            }
+
+            T* data() noexcept
+            {
+                return std::launder(reinterpret_cast<T*>(storage_));
+            }
+
+            std::span<const T> elements() noexcept
+            {
+                return {data(), size_};
+            }
+
+            template <typename... TArgs>
+            void emplace_back(TArgs&&... args)
+            {
+                std::construct_at(data() + size_, std::forward<TArgs>(args)...);
+                ++size_;
+            }
+
+            // trivially copyable elements written straight to data()
+            void set_size(std::size_t size) noexcept
+            {
+                static_assert(std::is_trivially_copyable_v<T>);
+                size_ = size;
+            }
+
+            void clear() noexcept
+            {
+                std::destroy_n(data(), size_);
+                size_ = 0;
+            }
+
+        private:
+            alignas(T) std::byte storage_[sizeof(T) * BlockSize];
+            std::size_t size_ = 0;
+        };
+
+        // appends block[i] for mask[i] != 0 to the destination
+        template <std::size_t BlockSize, typename T>
+        void compress(std::span<const T> block, const unsigned char* mask, Block<T, BlockSize>& destination)
+        {
+            if constexpr (!std::is_trivially_copyable_v<T>)
+            {
+                for (std::size_t i = 0; i < block.size(); ++i) // a copy of every element would cost more than the branch
+                {
+                    if (mask[i])
+                        destination.emplace_back(block[i]);
+                }
+            }
+            else
+            {
+                T* const out = destination.data();
+                std::size_t i = 0;
+                std::size_t kept = 0;
+
+#ifdef __AVX512F__
+                // a full vector is stored at the compressed position - it never passes the end of the current lanes
+                if constexpr ((sizeof(T) == 4 || sizeof(T) == 8) && BlockSize >= 16)
+                {
+                    constexpr std::size_t lanes = 64 / sizeof(T);
+                    for (; i + lanes <= block.size(); i += lanes)
+                    {
+                        const __m512i values = _mm512_loadu_si512(block.data() + i);
+
+                        // mask bytes to bits, compress in a register and a plain store - compress-stores are microcoded on some cores
+                        const __m128i bytes = lanes == 16 ? _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + i))
+                                                          : _mm_loadl_epi64(reinterpret_cast<const __m128i*>(mask + i));
+                        const auto bits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, _mm_setzero_si128())));
+
+                        if constexpr (sizeof(T) == 4)
+                            _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi32(static_cast<__mmask16>(bits), values));
+                        else
+                            _mm512_storeu_si512(out + kept, _mm512_maskz_compress_epi64(static_cast<__mmask8>(bits), values));
+                        kept += static_cast<std::size_t>(std::popcount(bits & ((1u << lanes) - 1)));
+                    }
+                }
+#endif
+
+                for (; i < block.size(); ++i) // branchless - the store always happens, the position moves for kept elements
+                {
+                    out[kept] = block[i];
+                    kept += mask[i];
+                }
+
+                destination.set_size(kept);
+            }
+        }
+
+        template <std::size_t BlockSize, std::size_t Index, typename T, typename TStages, typename Out>
+        Out process_block(std::span<const T> block, TStages& stages, Out out)
+        {
+            if constexpr (Index == std::tuple_size_v<TStages>)
+            {
+                return std::ranges::copy(block, std::move(out)).out;
+            }
+            else
+            {
+                auto& stage = std::get<Index>(stages);
+
+                if constexpr (requires { stage.func; })
+                {
+                    using U = std::remove_cvref_t<std::invoke_result_t<decltype(stage.func)&, const T&>>;
+
+                    // the last transform of a contiguous destination writes straight to it
+                    if constexpr (Index + 1 == std::tuple_size_v<TStages> && std::contiguous_iterator<Out>)
+                    {
+                        auto* const destination = std::to_address(out);
+                        for (std::size_t i = 0; i < block.size(); ++i)
+                            destination[i] = std::invoke(stage.func, block[i]);
+
+                        return out + static_cast<std::iter_difference_t<Out>>(block.size());
+                    }
+                    else
+                    {
+                        Block<U, BlockSize> transformed;
+                        for (std::size_t i = 0; i < block.size(); ++i)
+                            transformed.emplace_back(std::invoke(stage.func, block[i]));
+
+                        return process_block<BlockSize, Index + 1, U>(transformed.elements(), stages, std::move(out));
+                    }
+                }
+                else
+                {
+                    std::array<unsigned char, BlockSize> mask; // bytes rather than bool - the mask loop vectorizes
+                    for (std::size_t i = 0; i < block.size(); ++i)
+                        mask[i] = std::invoke(stage.pred, block[i]) ? 1 : 0;
+
+                    Block<T, BlockSize> compressed;
+                    compress<BlockSize>(block, mask.data(), compressed);
+
+                    return process_block<BlockSize, Index + 1, T>(compressed.elements(), stages, std::move(out));
+                }
+            }
+        }
+    } // namespace detail
+
+    // copies source | pipeline to the destination evaluating the pipeline block by block
+    template <std::size_t BlockSize = 256, std::ranges::input_range R, typename... TStages, std::weakly_incrementable Out>
+    Out copy(R&& source, Pipeline<TStages...> pipeline, Out out)
+    {
+        using T = std::ranges::range_value_t<R>;
+
+        if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R>)
+        {
+            // blocks are read in place
+            std::span<const T> all{std::ranges::data(source), std::ranges::size(source)};
+            for (std::size_t offset = 0; offset < all.size(); offset += BlockSize)
+                out = detail::process_block<BlockSize, 0, T>(all.subspan(offset, std::min(BlockSize, all.size() - offset)), pipeline.stages, std::move(out));
+        }
+        else
+        {
+            detail::Block<T, BlockSize> block;
+
+            auto it = std::ranges::begin(source);
+            const auto last = std::ranges::end(source);
+
+            if constexpr (std::ranges::random_access_range<R> && std::sized_sentinel_for<std::ranges::sentinel_t<R>, std::ranges::iterator_t<R>>)
+            {
+                // counted loads without the end check per element
+                for (auto remaining = static_cast<std::size_t>(last - it); remaining > 0;)
+                {
+                    const std::size_t count = std::min(remaining, BlockSize);
+                    for (std::size_t i = 0; i < count; ++i)
+                        block.emplace_back(it[static_cast<std::ranges::range_difference_t<R>>(i)]);
+                    it += static_cast<std::ranges::range_difference_t<R>>(count);
+                    remaining -= count;
+
+                    out = detail::process_block<BlockSize, 0, T>(block.elements(), pipeline.stages, std::move(out));
+                    block.clear();
+                }
+            }
+            else
+            {
+                while (it != last)
+                {
+                    for (std::size_t count = 0; count < BlockSize && it != last; ++count, ++it)
+                        block.emplace_back(*it);
+
+                    out = detail::process_block<BlockSize, 0, T>(block.elements(), pipeline.stages, std::move(out));
+                    block.clear();
+                }
+            }
+        }
+
+        return out;
+    }
+
+    template <std::size_t BlockSize = 256, std::ranges::input_range R, typename... TStages>
+    auto to_vector(R&& source, Pipeline<TStages...> pipeline)
+    {
+        std::vector<detail::output_t<std::ranges::range_value_t<R>, TStages...>> result;
+        if constexpr (std::ranges::sized_range<R>)
+            result.reserve(std::ranges::size(source)); // upper bound - filters only shrink the output
+
+        batch::copy<BlockSize>(std::forward<R>(source), std::move(pipeline), std::back_inserter(result));
+        return result;
+    }
+} // namespace rng::batch
+
+#endif
@@ -0,0 +1,130 @@
+#include "cache_view.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+#include <ranges>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    auto is_even = [](int x) { return x % 2 == 0; };
+
+    // compute-heavy kernel - the case caching is for
+    long heavy(int n)
+    {
+        double x = n;
+        for (int i = 0; i < 64; ++i)
+            x = std::sqrt(x * x + 1.0);
+        return static_cast<long>(x);
+    }
+} // namespace
+
+TEST_CASE("views::cache")
+{
+    static_assert(std::ranges::bidirectional_range<rng::CacheView<std::views::all_t<std::vector<int>&>>>);
+    static_assert(std::ranges::view<rng::CacheView<std::views::all_t<std::vector<int>&>>>);
+
+    std::vector<int> data(1'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    int calls = 0;
+    auto square = [&calls](int x) { ++calls; return x * x; };
+
+    SECTION("each element is evaluated once")
+    {
+        auto squares = data | std::views::transform(square) | rng::views::cache;
+
+        auto evens = squares | std::views::filter(is_even) | std::views::reverse;
+        const auto sum = std::accumulate(evens.begin(), evens.end(), 0L);
+        const auto count = std::ranges::distance(squares);
+
+        REQUIRE(sum == 166'167'000);
+        REQUIRE(count == 1'000);
+        REQUIRE(calls == 1'000);
+    }
+
+    SECTION("elements are evaluated as the view is consumed")
+    {
+        auto squares = data | std::views::transform(square) | rng::views::memoize;
+
+        REQUIRE(std::ranges::equal(squares | std::views::take(3), std::vector{0, 1, 4}));
+        REQUIRE(calls == 3);
+        REQUIRE(squares.cached() == 3);
+    }
+
+    SECTION("references stay valid while the cache grows")
+    {
+        auto squares = data | std::views::transform(square) | rng::views::cache;
+
+        const int& first = *squares.begin();
+        REQUIRE(std::ranges::distance(squares) == 1'000);
+
+        REQUIRE(&first == &*squares.begin());
+    }
+
+    SECTION("copies share the cache")
+    {
+        auto squares = data | std::views::transform(square) | rng::views::cache;
+        auto copy = squares;
+
+        REQUIRE(std::ranges::distance(squares) == 1'000);
+        REQUIRE(std::ranges::distance(copy) == 1'000);
+
+        REQUIRE(calls == 1'000);
+    }
+
+    SECTION("input range becomes multi-pass")
+    {
+        std::istringstream input{"1 2 3 4"};
+        auto numbers = std::views::istream<int>(input) | rng::views::cache;
+
+        helpers::print(numbers, "numbers");
+
+        REQUIRE(std::ranges::equal(numbers, std::vector{1, 2, 3, 4}));
+    }
+
+    SECTION("default-constructed view is empty")
+    {
+        decltype(std::views::iota(0, 10) | rng::views::cache) empty;
+
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(std::ranges::distance(empty) == 0);
+        REQUIRE(empty.cached() == 0);
+    }
+}
+
+TEST_CASE("views::cache - repeated passes over an expensive transform", "[.][benchmark]")
+{
+    std::vector<int> data(100'000);
+    std::iota(data.begin(), data.end(), 0);
+
+    // two passes over the filtered values, as helpers::print followed by a copy
+    auto two_passes = [](auto values) { return std::ranges::distance(values) + std::ranges::count(values, 0); };
+
+    long calls = 0;
+    auto counted_heavy = [&calls](int n) { ++calls; return heavy(n); };
+
+    two_passes(data | std::views::transform(counted_heavy) | std::views::filter(is_even));
+    std::cout << "transform calls without cache: " << std::exchange(calls, 0) << "\n";
+
+    two_passes(data | std::views::transform(counted_heavy) | rng::views::cache | std::views::filter(is_even));
+    std::cout << "transform calls with cache: " << calls << "\n";
+
+    BENCHMARK("transform - filter & count twice")
+    {
+        return two_passes(data | std::views::transform(heavy) | std::views::filter(is_even));
+    };
+
+    BENCHMARK("transform | cache - filter & count twice")
+    {
+        return two_passes(data | std::views::transform(heavy) | rng::views::cache | std::views::filter(is_even));
+    };
+}
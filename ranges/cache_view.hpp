@@ -0,0 +1,212 @@
+#ifndef CACHE_VIEW_HPP
+#define CACHE_VIEW_HPP
+
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+namespace rng
+{
+    namespace detail
+    {
+        // elements stored in chunks of 64, 128, 256, ... - appending never moves the stored ones,
+        // so references handed out stay valid
+        template <typename T>
+        class ChunkedBuffer
+        {
+        public:
+            static constexpr std::size_t first_chunk = 64;
+
+            std::size_t size() const noexcept
+            {
+                return size_;
+            }
+
+            const T& operator[](std::size_t index) const noexcept
+            {
+                const auto [chunk, offset] = locate(index);
+                return chunks_[chunk][offset];
+            }
+
+            template <typename... Args>
+            void emplace_back(Args&&... args)
+            {
+                const auto [chunk, offset] = locate(size_);
+                if (chunk == chunks_.size())
+                    chunks_.emplace_back().reserve(first_chunk << chunk);
+
+                chunks_[chunk].emplace_back(std::forward<Args>(args)...);
+                ++size_;
+            }
+
+        private:
+            std::vector<std::vector<T>> chunks_;
+            std::size_t size_ = 0;
+
+            // chunk k holds the elements [first_chunk * (2^k - 1), first_chunk * (2^(k+1) - 1))
+            static std::pair<std::size_t, std::size_t> locate(std::size_t index) noexcept
+            {
+                const auto chunk = static_cast<std::size_t>(std::bit_width(index / first_chunk + 1) - 1);
+                return {chunk, index - first_chunk * ((std::size_t{1} << chunk) - 1)};
+            }
+        };
+    } // namespace detail
+
+    // evaluates every element of the underlying view at most once - the results are stored as the view
+    // is consumed, so `data | views::transform(expensive) | rng::views::cache` may be filtered, reversed
+    // and iterated many times with one call of expensive per element;
+    // copies of the view share the cache, which is not synchronized (one thread at a time)
+    template <std::ranges::input_range V>
+        requires std::ranges::view<V>
+    class CacheView : public std::ranges::view_interface<CacheView<V>>
+    {
+        using Value = std::ranges::range_value_t<V>;
+
+        struct State
+        {
+            V base;
+            std::optional<std::ranges::iterator_t<V>> current; // next element to evaluate - begin() is called on first use
+            detail::ChunkedBuffer<Value> cache;
+
+            explicit State(V base)
+                : base{std::move(base)}
+            {
+            }
+
+            // true if the element exists - evaluates the elements up to it
+            bool fill(std::size_t index)
+            {
+                if (!current)
+                    current.emplace(std::ranges::begin(base));
+
+                for (; cache.size() <= index && *current != std::ranges::end(base); ++*current)
+                    cache.emplace_back(**current);
+
+                return index < cache.size();
+            }
+        };
+
+    public:
+        class iterator
+        {
+        public:
+            using value_type = Value;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+
+            iterator() = default;
+
+            iterator(State* state, std::size_t index) noexcept
+                : state_{state}
+                , index_{index}
+            {
+            }
+
+            const Value& operator*() const
+            {
+                state_->fill(index_);
+                return state_->cache[index_];
+            }
+
+            iterator& operator++() noexcept
+            {
+                ++index_;
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++index_;
+                return tmp;
+            }
+
+            iterator& operator--() noexcept
+            {
+                --index_;
+                return *this;
+            }
+
+            iterator operator--(int) noexcept
+            {
+                auto tmp = *this;
+                --index_;
+                return tmp;
+            }
+
+            bool operator==(const iterator& other) const noexcept
+            {
+                return index_ == other.index_;
+            }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return !state_ || !state_->fill(index_); // a default-constructed view is empty
+            }
+
+        private:
+            State* state_ = nullptr;
+            std::size_t index_ = 0;
+        };
+
+        CacheView() = default;
+
+        explicit CacheView(V base)
+            : state_{std::make_shared<State>(std::move(base))}
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator{state_.get(), 0};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+        // number of elements evaluated so far
+        std::size_t cached() const noexcept
+        {
+            return state_ ? state_->cache.size() : 0;
+        }
+
+    private:
+        std::shared_ptr<State> state_;
+    };
+
+    template <typename R>
+    CacheView(R&&) -> CacheView<std::views::all_t<R>>;
+
+    namespace views
+    {
+        struct CacheAdaptor
+        {
+            template <std::ranges::viewable_range R>
+                requires std::ranges::input_range<R>
+            auto operator()(R&& range) const
+            {
+                return CacheView{std::views::all(std::forward<R>(range))};
+            }
+
+            template <std::ranges::viewable_range R>
+                requires std::ranges::input_range<R>
+            friend auto operator|(R&& range, const CacheAdaptor& adaptor)
+            {
+                return adaptor(std::forward<R>(range));
+            }
+        };
+
+        // data | std::views::transform(expensive) | rng::views::cache
+        inline constexpr CacheAdaptor cache{};
+        inline constexpr CacheAdaptor memoize{};
+    } // namespace views
+} // namespace rng
+
+#endif
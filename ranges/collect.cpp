@@ -0,0 +1,148 @@
+#include "collect.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <iostream>
+#include <list>
+#include <memory_resource>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    auto square = [](int n) { return n * n; };
+    auto is_even = [](int x) { return x % 2 == 0; };
+
+    // allocations, reallocations (allocations while a block is already held) and the peak of allocated bytes
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        int allocations = 0;
+        std::size_t bytes = 0;
+        std::size_t peak_bytes = 0;
+
+    private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override
+        {
+            ++allocations;
+            bytes += size;
+            peak_bytes = std::max(peak_bytes, bytes);
+            return std::pmr::new_delete_resource()->allocate(size, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t size, std::size_t alignment) override
+        {
+            bytes -= size;
+            std::pmr::new_delete_resource()->deallocate(ptr, size, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+} // namespace
+
+TEST_CASE("collecting ranges into containers")
+{
+    auto data = std::views::iota(1, 1001);
+    const std::vector<int> expected = [&] {
+        std::vector<int> result;
+        for (int x : data | std::views::transform(square) | std::views::filter(is_even))
+            result.push_back(x);
+        return result;
+    }();
+
+    SECTION("sized range - one exact allocation")
+    {
+        CountingResource resource;
+        auto squares = data | std::views::transform(square) | rng::to<std::pmr::vector<int>>(&resource);
+
+        REQUIRE(squares.size() == 1000);
+        REQUIRE(squares.capacity() == 1000);
+        REQUIRE(resource.allocations == 1);
+    }
+
+    SECTION("unsized range - chunks spliced into one exact allocation")
+    {
+        CountingResource resource;
+        auto evens = data | std::views::transform(square) | std::views::filter(is_even) | rng::to<std::pmr::vector<int>>(&resource);
+
+        REQUIRE(std::ranges::equal(evens, expected));
+        REQUIRE(evens.capacity() == evens.size());
+        REQUIRE(resource.bytes == evens.size() * sizeof(int)); // chunks are released
+    }
+
+    SECTION("size hint")
+    {
+        auto evens = rng::to<std::vector<int>>(data | std::views::transform(square) | std::views::filter(is_even), rng::SizeHint{500});
+
+        REQUIRE(evens == expected);
+        REQUIRE(evens.capacity() == 500);
+    }
+
+    SECTION("deduced element type and other containers")
+    {
+        auto words = std::array{"one", "two", "three"} | std::views::transform([](auto s) { return std::string{s}; });
+
+        REQUIRE((words | rng::to<std::vector>()) == std::vector<std::string>{"one", "two", "three"});
+        REQUIRE((words | rng::to<std::list>()) == std::list<std::string>{"one", "two", "three"});
+        REQUIRE((words | rng::to<std::set>()) == std::set<std::string>{"one", "three", "two"});
+
+        REQUIRE(rng::to<std::vector>(words) == std::vector<std::string>{"one", "two", "three"});
+        REQUIRE(rng::to<std::vector>(data | std::views::filter(is_even), rng::SizeHint{500}).size() == 500);
+    }
+
+    SECTION("caller-provided storage")
+    {
+        std::array<int, 1000> buffer{};
+
+        auto filled = rng::collect_into(data | std::views::transform(square) | std::views::filter(is_even), std::span{buffer});
+        REQUIRE(std::ranges::equal(filled, expected));
+        REQUIRE(filled.data() == buffer.data());
+
+        std::array<int, 10> small{};
+        REQUIRE_THROWS_AS(rng::collect_into(data, std::span{small}), std::length_error);
+        REQUIRE_THROWS_AS(rng::collect_into(data | std::views::filter(is_even), std::span{small}), std::length_error);
+    }
+}
+
+TEST_CASE("collecting ranges - allocations", "[.][benchmark]")
+{
+    auto evens = std::views::iota(0, 10'000'000) | std::views::transform(square) | std::views::filter(is_even);
+
+    auto report = [](const char* name, auto collect) {
+        CountingResource resource;
+        auto result = collect(resource);
+        std::cout << name << ": " << result.size() << " items, allocations: " << resource.allocations
+                  << ", peak bytes: " << resource.peak_bytes << "\n";
+    };
+
+    report("vector(begin, end) of views::common", [&](auto& resource) {
+        auto common = evens | std::views::common;
+        return std::pmr::vector<int>(common.begin(), common.end(), &resource);
+    });
+    report("rng::to - chunked", [&](auto& resource) { return evens | rng::to<std::pmr::vector<int>>(&resource); });
+    report("rng::to - size hint", [&](auto& resource) { return evens | rng::to<std::pmr::vector<int>>(rng::SizeHint{5'000'000}, &resource); });
+
+    BENCHMARK("vector(begin, end) of views::common")
+    {
+        auto common = evens | std::views::common;
+        return std::vector<int>(common.begin(), common.end());
+    };
+
+    BENCHMARK("rng::to - chunked")
+    {
+        return evens | rng::to<std::vector<int>>();
+    };
+
+    BENCHMARK("rng::to - size hint")
+    {
+        return evens | rng::to<std::vector<int>>(rng::SizeHint{5'000'000});
+    };
+}
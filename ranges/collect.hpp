@@ -0,0 +1,218 @@
+#ifndef COLLECT_HPP
+#define COLLECT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rng
+{
+    // expected number of elements of a range whose size is unknown (e.g. after a filter)
+    struct SizeHint
+    {
+        std::size_t value;
+    };
+
+    namespace detail
+    {
+        template <typename C>
+        concept Reservable = requires(C& c, std::size_t n) { c.reserve(n); };
+
+        template <typename C, typename T>
+        void append(C& container, T&& value)
+        {
+            if constexpr (requires { container.push_back(std::forward<T>(value)); })
+                container.push_back(std::forward<T>(value));
+            else
+                container.insert(container.end(), std::forward<T>(value));
+        }
+
+        // elements of a range of unknown size gathered in chunks - a chunk never reallocates, so every element
+        // is moved once into the final container; chunks grow up to a cap to keep the unused capacity small
+        template <typename C, typename R>
+        void collect_chunked(C& container, R&& range)
+        {
+            using Value = std::ranges::range_value_t<C>;
+            using Allocator = typename std::allocator_traits<typename C::allocator_type>::template rebind_alloc<Value>;
+
+            std::vector<std::vector<Value, Allocator>> chunks;
+            std::size_t total = 0;
+            std::size_t capacity = 256;
+
+            auto it = std::ranges::begin(range);
+            const auto last = std::ranges::end(range);
+            while (it != last)
+            {
+                auto& chunk = chunks.emplace_back(Allocator(container.get_allocator()));
+                chunk.reserve(capacity);
+                for (; it != last && chunk.size() < capacity; ++it)
+                    chunk.push_back(*it);
+
+                total += chunk.size();
+                capacity = std::min<std::size_t>(capacity * 2, 64 * 1024);
+            }
+
+            container.reserve(container.size() + total);
+            for (auto& chunk : chunks)
+            {
+                std::ranges::move(chunk, std::back_inserter(container));
+                chunk.clear();
+                chunk.shrink_to_fit(); // released as soon as it is spliced
+            }
+        }
+
+        template <typename C, typename R>
+        void collect(C& container, R&& range, std::size_t hint)
+        {
+            if constexpr (Reservable<C> && std::ranges::sized_range<R>)
+            {
+                container.reserve(container.size() + static_cast<std::size_t>(std::ranges::size(range)));
+                for (auto&& item : range)
+                    append(container, std::forward<decltype(item)>(item));
+            }
+            else if constexpr (Reservable<C> && requires { typename C::allocator_type; })
+            {
+                if (hint > 0)
+                {
+                    container.reserve(container.size() + hint);
+                    for (auto&& item : range)
+                        append(container, std::forward<decltype(item)>(item));
+                }
+                else
+                    collect_chunked(container, std::forward<R>(range));
+            }
+            else
+            {
+                for (auto&& item : range)
+                    append(container, std::forward<decltype(item)>(item));
+            }
+        }
+
+        template <typename C, typename... Args>
+        struct ToAdaptor
+        {
+            std::tuple<Args...> args;
+            std::size_t hint = 0;
+
+            template <std::ranges::input_range R>
+            friend auto operator|(R&& range, ToAdaptor adaptor)
+            {
+                return std::apply(
+                    [&](auto&&... args) {
+                        C container(std::forward<decltype(args)>(args)...);
+                        detail::collect(container, std::forward<R>(range), adaptor.hint);
+                        return container;
+                    },
+                    std::move(adaptor.args));
+            }
+        };
+
+        template <template <typename...> typename C, typename... Args>
+        struct ToDeducedAdaptor
+        {
+            std::tuple<Args...> args;
+            std::size_t hint = 0;
+
+            template <std::ranges::input_range R>
+            friend auto operator|(R&& range, ToDeducedAdaptor adaptor)
+            {
+                using Container = C<std::ranges::range_value_t<R>>;
+                return std::forward<R>(range) | ToAdaptor<Container, Args...>{std::move(adaptor.args), adaptor.hint};
+            }
+        };
+    } // namespace detail
+
+    // materializes a range into a container - it is reserved exactly for sized ranges, with the hint if given,
+    // otherwise elements are gathered in chunks and spliced once; extra arguments go to the container's constructor
+    //   auto v = data | views::filter(is_even) | rng::to<std::vector<int>>();
+    //   auto v = rng::to<std::pmr::vector<int>>(data | views::filter(is_even), &resource);
+    template <typename C, std::ranges::input_range R, typename... Args>
+        requires(!std::ranges::view<C>)
+    C to(R&& range, Args&&... args)
+    {
+        C container(std::forward<Args>(args)...);
+        detail::collect(container, std::forward<R>(range), 0);
+        return container;
+    }
+
+    template <typename C, std::ranges::input_range R, typename... Args>
+        requires(!std::ranges::view<C>)
+    C to(R&& range, SizeHint hint, Args&&... args)
+    {
+        C container(std::forward<Args>(args)...);
+        detail::collect(container, std::forward<R>(range), hint.value);
+        return container;
+    }
+
+    template <typename C, typename... Args>
+        requires(!std::ranges::view<C>)
+    auto to(Args&&... args)
+    {
+        return detail::ToAdaptor<C, std::decay_t<Args>...>{{std::forward<Args>(args)...}};
+    }
+
+    template <typename C, typename... Args>
+        requires(!std::ranges::view<C>)
+    auto to(SizeHint hint, Args&&... args)
+    {
+        return detail::ToAdaptor<C, std::decay_t<Args>...>{{std::forward<Args>(args)...}, hint.value};
+    }
+
+    // element type deduced from the range: data | rng::to<std::vector>() or rng::to<std::vector>(data)
+    template <template <typename...> typename C, std::ranges::input_range R, typename... Args>
+    auto to(R&& range, Args&&... args)
+    {
+        return to<C<std::ranges::range_value_t<R>>>(std::forward<R>(range), std::forward<Args>(args)...);
+    }
+
+    template <template <typename...> typename C, std::ranges::input_range R, typename... Args>
+    auto to(R&& range, SizeHint hint, Args&&... args)
+    {
+        return to<C<std::ranges::range_value_t<R>>>(std::forward<R>(range), hint, std::forward<Args>(args)...);
+    }
+
+    template <template <typename...> typename C, typename... Args>
+    auto to(Args&&... args)
+    {
+        return detail::ToDeducedAdaptor<C, std::decay_t<Args>...>{{std::forward<Args>(args)...}};
+    }
+
+    template <template <typename...> typename C, typename... Args>
+    auto to(SizeHint hint, Args&&... args)
+    {
+        return detail::ToDeducedAdaptor<C, std::decay_t<Args>...>{{std::forward<Args>(args)...}, hint.value};
+    }
+
+    // copies a range into caller-provided storage and returns the filled part;
+    // std::length_error if the storage is too small (checked up front for sized ranges)
+    template <std::ranges::input_range R, typename T, std::size_t Extent>
+        requires std::indirectly_copyable<std::ranges::iterator_t<R>, T*>
+    std::span<T> collect_into(R&& range, std::span<T, Extent> destination)
+    {
+        if constexpr (std::ranges::sized_range<R>)
+        {
+            if (static_cast<std::size_t>(std::ranges::size(range)) > destination.size())
+                throw std::length_error{"collect_into: destination too small"};
+        }
+
+        std::size_t count = 0;
+        for (auto&& item : range)
+        {
+            if (count == destination.size())
+                throw std::length_error{"collect_into: destination too small"};
+            destination[count++] = std::forward<decltype(item)>(item);
+        }
+
+        return std::span<T>{destination}.first(count);
+    }
+} // namespace rng
+
+#endif
@@ -0,0 +1,125 @@
+#include "fast_split.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    std::vector<std::string_view> tokens(auto&& view)
+    {
+        std::vector<std::string_view> result;
+        for (auto&& token : view)
+            result.emplace_back(token);
+        return result;
+    }
+
+    std::vector<std::string_view> std_split(std::string_view text, std::string_view delimiter)
+    {
+        return tokens(std::views::split(text, delimiter)
+            | std::views::transform([](auto token) { return std::string_view(token.begin(), token.end()); }));
+    }
+
+    std::string make_text(std::size_t size)
+    {
+        const std::string_view words[] = {"lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing", "elit"};
+
+        std::string text;
+        for (std::size_t i = 0; text.size() < size; ++i)
+        {
+            text += words[(i * 7) % std::size(words)];
+            text += i % 5 == 4 ? "\t" : (i % 3 == 2 ? ", " : " ");
+        }
+        return text;
+    }
+} // namespace
+
+TEST_CASE("fast_split")
+{
+    SECTION("the same tokens as views::split")
+    {
+        const std::string long_text = make_text(1000) + "end";
+
+        for (std::string_view text : {""sv, " "sv, "abc"sv, "abc def ghi"sv, " abc  def "sv, "  "sv, std::string_view{long_text}})
+        {
+            REQUIRE(tokens(rng::fast_split(text, ' ')) == std_split(text, " "));
+
+            for (std::string_view delimiter : {" "sv, ", "sv, "def"sv, "consectetur adipiscing"sv, ""sv})
+                REQUIRE(tokens(rng::fast_split(text, delimiter)) == std_split(text, delimiter));
+        }
+    }
+
+    SECTION("delimiter at every position of a SIMD block")
+    {
+        for (std::size_t pos = 0; pos < 70; ++pos)
+        {
+            std::string text(70, 'x');
+            text[pos] = ',';
+
+            REQUIRE(tokens(rng::fast_split(text, ',')) == std_split(text, ","));
+            REQUIRE(tokens(rng::fast_split(text, "x,x"sv)) == std_split(text, "x,x"));
+        }
+    }
+
+    SECTION("overlapping occurrences of the pattern")
+    {
+        const std::string text(100, 'a');
+
+        REQUIRE(tokens(rng::fast_split(text, "aa"sv)) == std_split(text, "aa"));
+        REQUIRE(tokens(rng::fast_split(text, "aaa"sv)) == std_split(text, "aaa"));
+    }
+
+    SECTION("set of delimiters")
+    {
+        REQUIRE(tokens(rng::fast_split("abc def\tghi,jkl", rng::any_of{" \t,"})) == std::vector{"abc"sv, "def"sv, "ghi"sv, "jkl"sv});
+        REQUIRE(tokens(rng::fast_split("a,\tb", rng::any_of{" \t,"})) == std::vector{"a"sv, ""sv, "b"sv});
+
+        const std::string text = make_text(1000);
+        REQUIRE(tokens(rng::fast_split(text, rng::any_of{"0123456789 \t,"})) == tokens(rng::fast_split(text, rng::any_of{" \t,"})));
+    }
+
+    SECTION("empty set of delimiters - the whole text is one token")
+    {
+        const std::string text(100, 'a');
+        REQUIRE(tokens(rng::fast_split(text, rng::any_of{""})) == std::vector{std::string_view{text}});
+    }
+
+    SECTION("string_view tokens compose with other views")
+    {
+        auto lengths = rng::fast_split("one two three", ' ') | std::views::transform(&std::string_view::size);
+
+        REQUIRE(std::ranges::equal(lengths, std::vector{3u, 3u, 5u}));
+    }
+}
+
+TEST_CASE("fast_split vs views::split", "[.][benchmark]")
+{
+    const std::string text = make_text(16 * 1024 * 1024);
+
+    BENCHMARK("views::split")
+    {
+        return std::ranges::distance(std::views::split(text, " "sv));
+    };
+
+    BENCHMARK("fast_split - byte")
+    {
+        return std::ranges::distance(rng::fast_split(text, ' '));
+    };
+
+    BENCHMARK("fast_split - string")
+    {
+        return std::ranges::distance(rng::fast_split(text, ", "sv));
+    };
+
+    BENCHMARK("fast_split - any_of")
+    {
+        return std::ranges::distance(rng::fast_split(text, rng::any_of{" \t,"}));
+    };
+}
@@ -0,0 +1,326 @@
+#ifndef FAST_SPLIT_HPP
+#define FAST_SPLIT_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace rng
+{
+    namespace detail
+    {
+        // byte-wise comparisons of a block - bit i of the mask is set for a match at byte i
+#if defined(__AVX2__)
+        struct Simd
+        {
+            using Vec = __m256i;
+            static constexpr std::size_t width = 32;
+
+            static Vec load(const char* data) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+            static Vec splat(char c) noexcept { return _mm256_set1_epi8(c); }
+            static Vec eq(Vec a, Vec b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+            static Vec bit_or(Vec a, Vec b) noexcept { return _mm256_or_si256(a, b); }
+            static Vec bit_and(Vec a, Vec b) noexcept { return _mm256_and_si256(a, b); }
+            static Vec all() noexcept { return _mm256_set1_epi8(-1); }
+            static Vec none() noexcept { return _mm256_setzero_si256(); }
+            static std::uint64_t mask(Vec v) noexcept { return static_cast<std::uint32_t>(_mm256_movemask_epi8(v)); }
+        };
+#elif defined(__SSE2__)
+        struct Simd
+        {
+            using Vec = __m128i;
+            static constexpr std::size_t width = 16;
+
+            static Vec load(const char* data) noexcept { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+            static Vec splat(char c) noexcept { return _mm_set1_epi8(c); }
+            static Vec eq(Vec a, Vec b) noexcept { return _mm_cmpeq_epi8(a, b); }
+            static Vec bit_or(Vec a, Vec b) noexcept { return _mm_or_si128(a, b); }
+            static Vec bit_and(Vec a, Vec b) noexcept { return _mm_and_si128(a, b); }
+            static Vec all() noexcept { return _mm_set1_epi8(-1); }
+            static Vec none() noexcept { return _mm_setzero_si128(); }
+            static std::uint64_t mask(Vec v) noexcept { return static_cast<std::uint32_t>(_mm_movemask_epi8(v)); }
+        };
+#endif
+
+        // a delimiter provides:
+        //  - length()        - bytes skipped after a match
+        //  - matches(p)      - scalar test of the position p
+        //  - candidates(p)   - SIMD mask of possible matches at [p, p + Simd::width)
+        //  - verify(p)       - confirms a candidate
+        struct ByteDelimiter
+        {
+            char delimiter;
+
+            std::size_t length() const noexcept { return 1; }
+
+            bool matches(const char* p) const noexcept { return *p == delimiter; }
+
+            bool verify(const char*) const noexcept { return true; }
+
+#if defined(__SSE2__) || defined(__AVX2__)
+            Simd::Vec candidates(const char* p) const noexcept
+            {
+                return Simd::eq(Simd::load(p), Simd::splat(delimiter));
+            }
+#endif
+        };
+
+        // sets of more than 8 bytes are checked byte by byte
+        struct AnyOfDelimiter
+        {
+            std::string_view set;
+
+            std::size_t length() const noexcept { return 1; }
+
+            bool matches(const char* p) const noexcept { return set.find(*p) != std::string_view::npos; }
+
+            bool verify(const char* p) const noexcept { return set.size() <= 8 || matches(p); }
+
+#if defined(__SSE2__) || defined(__AVX2__)
+            Simd::Vec candidates(const char* p) const noexcept
+            {
+                if (set.empty())
+                    return Simd::none();
+                if (set.size() > 8)
+                    return Simd::all();
+
+                const auto block = Simd::load(p);
+                auto result = Simd::eq(block, Simd::splat(set.front()));
+                for (std::size_t k = 1; k < set.size(); ++k)
+                    result = Simd::bit_or(result, Simd::eq(block, Simd::splat(set[k])));
+                return result;
+            }
+#endif
+        };
+
+        // candidates are the positions where the first and the last byte of the pattern match -
+        // only they are compared with memcmp
+        struct StringDelimiter
+        {
+            std::string_view pattern;
+
+            std::size_t length() const noexcept { return pattern.size(); }
+
+            bool matches(const char* p) const noexcept { return std::memcmp(p, pattern.data(), pattern.size()) == 0; }
+
+            bool verify(const char* p) const noexcept
+            {
+                return pattern.size() <= 2 || std::memcmp(p + 1, pattern.data() + 1, pattern.size() - 2) == 0;
+            }
+
+#if defined(__SSE2__) || defined(__AVX2__)
+            Simd::Vec candidates(const char* p) const noexcept
+            {
+                return Simd::bit_and(Simd::eq(Simd::load(p), Simd::splat(pattern.front())),
+                                     Simd::eq(Simd::load(p + pattern.size() - 1), Simd::splat(pattern.back())));
+            }
+#endif
+        };
+
+        // finds matches in windows of 64 positions - the mask of a window is computed once and consumed
+        // match by match, so short tokens do not rescan the text
+        template <typename Delimiter>
+        class MatchScanner
+        {
+        public:
+            MatchScanner() = default;
+
+            MatchScanner(std::string_view text, Delimiter delimiter) noexcept
+                : text_{text}
+                , delimiter_{delimiter}
+                , positions_{text.size() >= delimiter.length() ? text.size() - delimiter.length() + 1 : 0}
+                , window_{text.size()}
+            {
+            }
+
+            const Delimiter& delimiter() const noexcept
+            {
+                return delimiter_;
+            }
+
+            // start of the first match at or after from - text.size() if there is none
+            std::size_t find(std::size_t from) noexcept
+            {
+                if (delimiter_.length() == 0) // as views::split - an empty pattern makes every element a token
+                    return from + 1 < text_.size() ? from + 1 : text_.size();
+
+                if (from < window_ || from >= window_ + 64)
+                    load_window(from);
+                else if (from > window_)
+                    matches_ &= ~std::uint64_t{0} << (from - window_);
+
+                while (true)
+                {
+                    for (; matches_ != 0; matches_ &= matches_ - 1)
+                    {
+                        const std::size_t pos = window_ + static_cast<std::size_t>(std::countr_zero(matches_));
+                        if (delimiter_.verify(text_.data() + pos))
+                            return pos;
+                    }
+
+                    if (window_ + 64 >= positions_)
+                        return text_.size();
+                    load_window(window_ + 64);
+                }
+            }
+
+        private:
+            std::string_view text_;
+            Delimiter delimiter_{};
+            std::size_t positions_ = 0; // a match may start at [0, positions_)
+            std::size_t window_ = 0;
+            std::uint64_t matches_ = 0; // candidates in [window_, window_ + 64) not consumed yet
+
+            void load_window(std::size_t first) noexcept
+            {
+                window_ = first;
+                matches_ = 0;
+
+#if defined(__SSE2__) || defined(__AVX2__)
+                // the last block reads up to first + 64 + length - 1 <= text.size()
+                if (first + 64 <= positions_)
+                {
+                    for (std::size_t k = 0; k < 64; k += Simd::width)
+                        matches_ |= Simd::mask(delimiter_.candidates(text_.data() + first + k)) << k;
+                    return;
+                }
+#endif
+                const std::size_t last = std::min(first + 64, positions_);
+                for (std::size_t pos = first; pos < last; ++pos)
+                    matches_ |= std::uint64_t{delimiter_.matches(text_.data() + pos)} << (pos - first);
+            }
+        };
+    } // namespace detail
+
+    // any of the bytes is a delimiter: fast_split(text, any_of{" \t,"})
+    struct any_of
+    {
+        std::string_view set;
+    };
+
+    // tokens of a text as string_views - the same tokens as std::views::split(text, delimiter)
+    // including the empty ones between adjacent delimiters and after a trailing delimiter
+    template <typename Delimiter>
+    class FastSplitView : public std::ranges::view_interface<FastSplitView<Delimiter>>
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(std::string_view text, Delimiter delimiter) noexcept
+                : text_{text}
+                , scanner_{text, delimiter}
+                , next_{text.empty() ? 0 : scanner_.find(0)}
+            {
+            }
+
+            std::string_view operator*() const noexcept
+            {
+                return text_.substr(current_, next_ - current_);
+            }
+
+            iterator& operator++() noexcept
+            {
+                current_ = next_;
+                if (current_ != text_.size())
+                {
+                    current_ += scanner_.delimiter().length();
+                    if (current_ == text_.size())
+                    {
+                        trailing_empty_ = true;
+                        next_ = current_;
+                    }
+                    else
+                        next_ = scanner_.find(current_);
+                }
+                else
+                    trailing_empty_ = false;
+
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator& other) const noexcept
+            {
+                return current_ == other.current_ && trailing_empty_ == other.trailing_empty_;
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return current_ == text_.size() && !trailing_empty_;
+            }
+
+        private:
+            std::string_view text_;
+            detail::MatchScanner<Delimiter> scanner_;
+            std::size_t current_ = 0;
+            std::size_t next_ = 0; // start of the delimiter after the token (or the end of the text)
+            bool trailing_empty_ = false;
+        };
+
+        FastSplitView() = default;
+
+        FastSplitView(std::string_view text, Delimiter delimiter) noexcept
+            : text_{text}
+            , delimiter_{delimiter}
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator{text_, delimiter_};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+    private:
+        std::string_view text_;
+        Delimiter delimiter_{};
+    };
+
+    inline FastSplitView<detail::ByteDelimiter> fast_split(std::string_view text, char delimiter) noexcept
+    {
+        return {text, detail::ByteDelimiter{delimiter}};
+    }
+
+    // note: a string literal pattern for std::views::split includes the terminating '\0' - here it does not
+    inline FastSplitView<detail::StringDelimiter> fast_split(std::string_view text, std::string_view delimiter) noexcept
+    {
+        return {text, detail::StringDelimiter{delimiter}};
+    }
+
+    inline FastSplitView<detail::AnyOfDelimiter> fast_split(std::string_view text, any_of delimiters) noexcept
+    {
+        return {text, detail::AnyOfDelimiter{delimiters.set}};
+    }
+} // namespace rng
+
+// tokens point into the text, not into the view
+template <typename Delimiter>
+inline constexpr bool std::ranges::enable_borrowed_range<rng::FastSplitView<Delimiter>> = true;
+
+#endif
@@ -0,0 +1,210 @@
+#include "flat_map.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    // stateful comparator - keys with equal remainders are equivalent
+    struct ByMod
+    {
+        int divisor = 1;
+
+        bool operator()(int a, int b) const
+        {
+            return a % divisor < b % divisor;
+        }
+    };
+
+    // throws when constructed from a negative number
+    struct Checked
+    {
+        int value;
+
+        explicit Checked(int value)
+            : value{value}
+        {
+            if (value < 0)
+                throw std::invalid_argument{"negative"};
+        }
+    };
+} // namespace
+
+TEST_CASE("flat_map")
+{
+    rng::FlatMap<int, std::string> dict = {{3, "three"}, {1, "one"}, {2, "two"}, {1, "uno"}};
+
+    SECTION("bulk construction sorts and keeps the first of repeated keys")
+    {
+        REQUIRE(dict.size() == 3);
+        REQUIRE(std::ranges::equal(dict.keys(), std::vector{1, 2, 3}));
+        REQUIRE(std::ranges::equal(dict.values(), std::vector<std::string>{"one", "two", "three"}));
+
+        REQUIRE_THROWS_AS((rng::FlatMap<int, int>{std::vector{1, 2}, std::vector{1}}), std::invalid_argument);
+    }
+
+    SECTION("key/value views as for std::map")
+    {
+        helpers::print(dict | std::views::keys, "keys");
+        helpers::print(dict | std::views::values, "values");
+
+        REQUIRE(std::ranges::equal(dict | std::views::keys, dict.keys()));
+        REQUIRE(std::ranges::equal(dict | std::views::values, dict.values()));
+        REQUIRE(std::ranges::equal(dict | std::views::elements<0>, std::vector{1, 2, 3}));
+    }
+
+    SECTION("lookup")
+    {
+        REQUIRE(dict.find(2)->second == "two");
+        REQUIRE(dict.find(4) == dict.end());
+        REQUIRE(dict.contains(3));
+        REQUIRE(dict.at(1) == "one");
+        REQUIRE_THROWS_AS(dict.at(0), std::out_of_range);
+    }
+
+    SECTION("modification keeps the order")
+    {
+        dict[0] = "zero";
+        dict[2] = "dwa";
+        REQUIRE(dict.insert({5, "five"}).second);
+        REQUIRE_FALSE(dict.insert({5, "cinco"}).second);
+        REQUIRE(dict.erase(3) == 1);
+
+        REQUIRE(std::ranges::equal(dict.keys(), std::vector{0, 1, 2, 5}));
+        REQUIRE(std::ranges::equal(dict.values(), std::vector<std::string>{"zero", "one", "dwa", "five"}));
+    }
+
+    SECTION("a throwing value constructor leaves the map unchanged")
+    {
+        rng::FlatMap<int, Checked> checked;
+        checked.try_emplace(1, 10);
+        checked.try_emplace(3, 30);
+
+        REQUIRE_THROWS_AS(checked.try_emplace(2, -1), std::invalid_argument);
+
+        REQUIRE(checked.size() == 2);
+        REQUIRE_FALSE(checked.contains(2));
+        REQUIRE(checked.at(1).value == 10);
+        REQUIRE(checked.at(3).value == 30);
+    }
+
+    SECTION("copies keep the comparator")
+    {
+        rng::FlatMap<int, int, ByMod> by_mod_3{std::vector{1, 5}, std::vector{10, 50}, ByMod{3}};
+        rng::FlatMap<int, int, ByMod> copy(by_mod_3); // non-const lvalue
+
+        REQUIRE(by_mod_3.contains(4));
+        REQUIRE(copy.contains(4));
+        REQUIRE(copy.at(4) == 10);
+        REQUIRE(std::ranges::equal(copy.keys(), by_mod_3.keys()));
+    }
+
+    SECTION("values are writable through iterators")
+    {
+        for (auto [key, value] : dict)
+            value += "!";
+
+        REQUIRE(dict.at(3) == "three!");
+    }
+}
+
+TEST_CASE("flat_set")
+{
+    rng::FlatSet<int> set = {5, 1, 3, 1, 5};
+
+    REQUIRE(std::ranges::equal(set.keys(), std::vector{1, 3, 5}));
+    REQUIRE(set.contains(3));
+    REQUIRE_FALSE(set.contains(4));
+    REQUIRE(set.insert(4).second);
+    REQUIRE(set.erase(1) == 1);
+    REQUIRE(std::ranges::equal(set, std::vector{3, 4, 5}));
+}
+
+TEST_CASE("branchless lower_bound")
+{
+    std::vector<int> sorted = {1, 3, 3, 5, 7, 9, 11};
+
+    for (int size = 0; size <= static_cast<int>(sorted.size()); ++size)
+    {
+        std::span<const int> part{sorted.data(), static_cast<std::size_t>(size)};
+        for (int key = 0; key <= 12; ++key)
+            REQUIRE(rng::detail::branchless_lower_bound(part, key, std::less{})
+                == static_cast<std::size_t>(std::ranges::lower_bound(part, key) - part.begin()));
+    }
+}
+
+TEST_CASE("flat_map vs std::map and std::unordered_map", "[.][benchmark]")
+{
+    constexpr int size = 1'000'000;
+
+    std::vector<int> keys(size);
+    std::ranges::generate(keys, std::mt19937{42});
+    std::vector<int> values(size, 1);
+
+    const rng::FlatMap<int, int> flat_map{keys, values};
+    std::map<int, int> map;
+    for (int key : keys)
+        map.emplace(key, 1);
+    const std::unordered_map<int, int> hash_map(map.begin(), map.end());
+
+    std::vector<int> lookups(keys.begin(), keys.begin() + 100'000);
+    std::ranges::shuffle(lookups, std::mt19937{7});
+
+    BENCHMARK("iteration - std::map")
+    {
+        long sum = 0;
+        for (int value : map | std::views::values)
+            sum += value;
+        return sum;
+    };
+
+    BENCHMARK("iteration - std::unordered_map")
+    {
+        long sum = 0;
+        for (int value : hash_map | std::views::values)
+            sum += value;
+        return sum;
+    };
+
+    BENCHMARK("iteration - FlatMap")
+    {
+        long sum = 0;
+        for (int value : flat_map.values())
+            sum += value;
+        return sum;
+    };
+
+    BENCHMARK("lookup - std::map")
+    {
+        long sum = 0;
+        for (int key : lookups)
+            sum += map.find(key)->second;
+        return sum;
+    };
+
+    BENCHMARK("lookup - std::unordered_map")
+    {
+        long sum = 0;
+        for (int key : lookups)
+            sum += hash_map.find(key)->second;
+        return sum;
+    };
+
+    BENCHMARK("lookup - FlatMap")
+    {
+        long sum = 0;
+        for (int key : lookups)
+            sum += flat_map.find(key)->second;
+        return sum;
+    };
+}
@@ -0,0 +1,363 @@
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rng
+{
+    namespace detail
+    {
+        // lower_bound without a data-dependent branch - the loop runs log2(n) times and the step is a conditional move
+        template <typename T, typename K, typename Compare>
+        std::size_t branchless_lower_bound(std::span<const T> sorted, const K& key, const Compare& comp)
+        {
+            if (sorted.empty())
+                return 0;
+
+            const T* base = sorted.data();
+            std::size_t n = sorted.size();
+            while (n > 1)
+            {
+                const std::size_t half = n / 2;
+                base = comp(base[half], key) ? base + half : base;
+                n -= half;
+            }
+
+            return static_cast<std::size_t>(base - sorted.data()) + (comp(*base, key) ? 1 : 0);
+        }
+
+        // sorts the indexes of keys and drops repeated keys - the first occurrence wins, as for std::map::insert
+        template <typename Key, typename Compare>
+        std::vector<std::size_t> sorted_unique_order(const std::vector<Key>& keys, const Compare& comp)
+        {
+            std::vector<std::size_t> order(keys.size());
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::ranges::stable_sort(order, comp, [&](std::size_t i) -> const Key& { return keys[i]; });
+
+            const auto duplicates = std::ranges::unique(order, [&](std::size_t a, std::size_t b) { return !comp(keys[a], keys[b]) && !comp(keys[b], keys[a]); });
+            order.erase(duplicates.begin(), duplicates.end());
+            return order;
+        }
+
+        template <typename T>
+        std::vector<T> gather(std::vector<T>& items, const std::vector<std::size_t>& order)
+        {
+            std::vector<T> result;
+            result.reserve(order.size());
+            for (std::size_t i : order)
+                result.push_back(std::move(items[i]));
+            return result;
+        }
+    } // namespace detail
+
+    // sorted map kept in two columns - keys and values in separate contiguous vectors, so scans of keys
+    // (lookups) or values touch only the memory they need; insertion and erasure are O(n)
+    template <typename Key, typename Value, typename Compare = std::less<Key>>
+    class FlatMap
+    {
+        template <bool IsConst>
+        class Iterator
+        {
+            using MapPtr = std::conditional_t<IsConst, const FlatMap*, FlatMap*>;
+            using MappedRef = std::conditional_t<IsConst, const Value&, Value&>;
+
+        public:
+            using value_type = std::pair<Key, Value>;
+            using reference = std::pair<const Key&, MappedRef>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+
+            struct arrow_proxy
+            {
+                reference ref;
+                const reference* operator->() const noexcept { return &ref; }
+            };
+
+            Iterator() = default;
+
+            Iterator(MapPtr map, std::size_t index) noexcept
+                : map_{map}
+                , index_{index}
+            {
+            }
+
+            operator Iterator<true>() const noexcept
+                requires(!IsConst)
+            {
+                return {map_, index_};
+            }
+
+            reference operator*() const noexcept { return {map_->keys_[index_], map_->values_[index_]}; }
+            arrow_proxy operator->() const noexcept { return {**this}; }
+            reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+            Iterator& operator++() noexcept { ++index_; return *this; }
+            Iterator operator++(int) noexcept { auto tmp = *this; ++index_; return tmp; }
+            Iterator& operator--() noexcept { --index_; return *this; }
+            Iterator operator--(int) noexcept { auto tmp = *this; --index_; return tmp; }
+
+            Iterator& operator+=(difference_type n) noexcept { index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n); return *this; }
+            Iterator& operator-=(difference_type n) noexcept { return *this += -n; }
+            friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+            friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+            friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const Iterator& a, const Iterator& b) noexcept
+            {
+                return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return index_ == other.index_; }
+            auto operator<=>(const Iterator& other) const noexcept { return index_ <=> other.index_; }
+
+            std::size_t index() const noexcept { return index_; }
+
+        private:
+            MapPtr map_ = nullptr;
+            std::size_t index_ = 0;
+        };
+
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = std::size_t;
+        using key_compare = Compare;
+        using iterator = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        FlatMap() = default;
+
+        explicit FlatMap(Compare comp)
+            : comp_{std::move(comp)}
+        {
+        }
+
+        // bulk construction from unsorted columns - one sort instead of n insertions
+        FlatMap(std::vector<Key> keys, std::vector<Value> values, Compare comp = Compare{})
+            : comp_{std::move(comp)}
+        {
+            if (keys.size() != values.size())
+                throw std::invalid_argument{"FlatMap: keys and values differ in size"};
+
+            const auto order = detail::sorted_unique_order(keys, comp_);
+            keys_ = detail::gather(keys, order);
+            values_ = detail::gather(values, order);
+        }
+
+        template <std::ranges::input_range R>
+            requires(!std::same_as<std::remove_cvref_t<R>, FlatMap>) // copies keep the comparator & skip the sort
+            && requires(std::ranges::range_reference_t<R> item) { std::get<0>(item); std::get<1>(item); }
+        explicit FlatMap(R&& items, Compare comp = Compare{})
+            : FlatMap{split_columns(std::forward<R>(items)), std::move(comp)}
+        {
+        }
+
+        FlatMap(std::initializer_list<value_type> items, Compare comp = Compare{})
+            : FlatMap{std::views::all(items), std::move(comp)}
+        {
+        }
+
+        std::span<const Key> keys() const noexcept { return keys_; }
+        std::span<const Value> values() const noexcept { return values_; }
+        std::span<Value> values() noexcept { return values_; }
+
+        size_type size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        iterator begin() noexcept { return {this, 0}; }
+        iterator end() noexcept { return {this, size()}; }
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, size()}; }
+
+        iterator lower_bound(const Key& key) noexcept { return {this, lower_bound_index(key)}; }
+        const_iterator lower_bound(const Key& key) const noexcept { return {this, lower_bound_index(key)}; }
+
+        iterator find(const Key& key) noexcept { return {this, find_index(key)}; }
+        const_iterator find(const Key& key) const noexcept { return {this, find_index(key)}; }
+
+        bool contains(const Key& key) const noexcept { return find_index(key) != size(); }
+
+        Value& at(const Key& key) { return values_[checked_index(key)]; }
+        const Value& at(const Key& key) const { return values_[checked_index(key)]; }
+
+        Value& operator[](const Key& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            const std::size_t index = lower_bound_index(key);
+            if (index != size() && !comp_(key, keys_[index]))
+                return {iterator{this, index}, false};
+
+            keys_.insert(keys_.begin() + static_cast<std::ptrdiff_t>(index), key);
+            try
+            {
+                values_.emplace(values_.begin() + static_cast<std::ptrdiff_t>(index), std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index)); // the columns stay aligned
+                throw;
+            }
+            return {iterator{this, index}, true};
+        }
+
+        std::pair<iterator, bool> insert(value_type item)
+        {
+            return try_emplace(item.first, std::move(item.second));
+        }
+
+        size_type erase(const Key& key)
+        {
+            const std::size_t index = find_index(key);
+            if (index == size())
+                return 0;
+
+            keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index));
+            values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(index));
+            return 1;
+        }
+
+        void reserve(size_type capacity)
+        {
+            keys_.reserve(capacity);
+            values_.reserve(capacity);
+        }
+
+    private:
+        std::vector<Key> keys_;
+        std::vector<Value> values_;
+        [[no_unique_address]] Compare comp_{};
+
+        template <typename R>
+        static std::pair<std::vector<Key>, std::vector<Value>> split_columns(R&& items)
+        {
+            std::pair<std::vector<Key>, std::vector<Value>> columns;
+            if constexpr (std::ranges::sized_range<R>)
+            {
+                columns.first.reserve(std::ranges::size(items));
+                columns.second.reserve(std::ranges::size(items));
+            }
+
+            for (auto&& item : items)
+            {
+                columns.first.push_back(std::get<0>(item));
+                columns.second.push_back(std::get<1>(item));
+            }
+            return columns;
+        }
+
+        FlatMap(std::pair<std::vector<Key>, std::vector<Value>> columns, Compare comp)
+            : FlatMap{std::move(columns.first), std::move(columns.second), std::move(comp)}
+        {
+        }
+
+        std::size_t lower_bound_index(const Key& key) const noexcept
+        {
+            return detail::branchless_lower_bound(std::span<const Key>{keys_}, key, comp_);
+        }
+
+        std::size_t find_index(const Key& key) const noexcept
+        {
+            const std::size_t index = lower_bound_index(key);
+            return index != size() && !comp_(key, keys_[index]) ? index : size();
+        }
+
+        std::size_t checked_index(const Key& key) const
+        {
+            const std::size_t index = find_index(key);
+            if (index == size())
+                throw std::out_of_range{"FlatMap: key not found"};
+            return index;
+        }
+    };
+
+    // sorted unique keys in a contiguous vector
+    template <typename Key, typename Compare = std::less<Key>>
+    class FlatSet
+    {
+    public:
+        using key_type = Key;
+        using value_type = Key;
+        using size_type = std::size_t;
+        using const_iterator = typename std::vector<Key>::const_iterator;
+        using iterator = const_iterator;
+
+        FlatSet() = default;
+
+        // bulk construction - sort and dedup once
+        explicit FlatSet(std::vector<Key> keys, Compare comp = Compare{})
+            : keys_{std::move(keys)}
+            , comp_{std::move(comp)}
+        {
+            std::ranges::sort(keys_, comp_);
+            const auto duplicates = std::ranges::unique(keys_, [&](const Key& a, const Key& b) { return !comp_(a, b) && !comp_(b, a); });
+            keys_.erase(duplicates.begin(), duplicates.end());
+        }
+
+        FlatSet(std::initializer_list<Key> keys, Compare comp = Compare{})
+            : FlatSet{std::vector<Key>(keys), std::move(comp)}
+        {
+        }
+
+        std::span<const Key> keys() const noexcept { return keys_; }
+
+        size_type size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        const_iterator begin() const noexcept { return keys_.begin(); }
+        const_iterator end() const noexcept { return keys_.end(); }
+
+        const_iterator lower_bound(const Key& key) const noexcept
+        {
+            return keys_.begin() + static_cast<std::ptrdiff_t>(detail::branchless_lower_bound(std::span<const Key>{keys_}, key, comp_));
+        }
+
+        const_iterator find(const Key& key) const noexcept
+        {
+            const auto it = lower_bound(key);
+            return it != end() && !comp_(key, *it) ? it : end();
+        }
+
+        bool contains(const Key& key) const noexcept { return find(key) != end(); }
+
+        std::pair<const_iterator, bool> insert(const Key& key)
+        {
+            const auto it = lower_bound(key);
+            if (it != end() && !comp_(key, *it))
+                return {it, false};
+            return {keys_.insert(it, key), true};
+        }
+
+        size_type erase(const Key& key)
+        {
+            const auto it = find(key);
+            if (it == end())
+                return 0;
+            keys_.erase(it);
+            return 1;
+        }
+
+    private:
+        std::vector<Key> keys_;
+        [[no_unique_address]] Compare comp_{};
+    };
+} // namespace rng
+
+#endif
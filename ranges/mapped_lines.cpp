@@ -0,0 +1,146 @@
+#include "mapped_lines.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace std::literals;
+
+namespace
+{
+    class TempFile
+    {
+    public:
+        TempFile(std::string_view name, std::string_view content)
+            : path_{std::filesystem::temp_directory_path() / name}
+        {
+            std::ofstream{path_, std::ios::binary} << content;
+        }
+
+        TempFile(const TempFile&) = delete;
+        TempFile& operator=(const TempFile&) = delete;
+
+        ~TempFile()
+        {
+            std::filesystem::remove(path_);
+        }
+
+        const std::filesystem::path& path() const noexcept
+        {
+            return path_;
+        }
+
+    private:
+        std::filesystem::path path_;
+    };
+
+    std::pair<std::string_view, std::string_view> split(std::string_view line, char separator = '/')
+    {
+        if (auto pos = line.find(separator); pos != std::string_view::npos)
+            return {line.substr(0, pos), line.substr(pos + 1)};
+        return {};
+    }
+
+    std::vector<std::string_view> to_vector(rng::LinesView lines)
+    {
+        return {lines.begin(), std::ranges::next(lines.begin(), lines.end())};
+    }
+} // namespace
+
+TEST_CASE("lines of a text")
+{
+    static_assert(std::ranges::forward_range<rng::LinesView>);
+    static_assert(std::ranges::view<rng::LinesView>);
+
+    REQUIRE(to_vector(rng::lines("")).empty());
+    REQUIRE(to_vector(rng::lines("one")) == std::vector{"one"sv});
+    REQUIRE(to_vector(rng::lines("one\n")) == std::vector{"one"sv});
+    REQUIRE(to_vector(rng::lines("one\n\ntwo")) == std::vector{"one"sv, ""sv, "two"sv});
+    REQUIRE(to_vector(rng::lines("\n")) == std::vector{""sv});
+}
+
+TEST_CASE("mapped_lines")
+{
+    const TempFile file{"mapped_lines_test.txt",
+        "# Comment 1\n"
+        "# Comment 2\n"
+        "# Comment 3\n"
+        "1/one\n"
+        "2/two\n"
+        "\n"
+        "3/three\n"
+        "4/four\n"
+        "5/five\n"
+        "\n"
+        "\n"
+        "6/six\n"};
+
+    SECTION("the exercise pipeline straight from the file")
+    {
+        auto result = rng::mapped_lines(file.path())
+            | std::views::drop_while([](std::string_view sv) { return sv.starts_with("#"); })
+            | std::views::filter([](std::string_view sv) { return !sv.empty(); })
+            | std::views::transform([](auto sv) { return split(sv); })
+            | std::views::elements<1>;
+
+        auto expected_result = {"one"sv, "two"sv, "three"sv, "four"sv, "five"sv, "six"sv};
+
+        REQUIRE(std::ranges::equal(result, expected_result));
+    }
+
+    SECTION("copies of the view share the mapping")
+    {
+        rng::LinesView copy;
+        {
+            auto lines = rng::mapped_lines(file.path());
+            copy = lines;
+        }
+
+        REQUIRE(*copy.begin() == "# Comment 1");
+    }
+
+    SECTION("empty file")
+    {
+        const TempFile empty{"mapped_lines_test_empty.txt", ""};
+
+        REQUIRE(rng::mapped_lines(empty.path()).empty());
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS(rng::mapped_lines("/nonexistent/records.txt"), std::system_error);
+    }
+}
+
+TEST_CASE("mapped_lines vs getline", "[.][benchmark]")
+{
+    std::string content = "# generated\n";
+    for (int i = 0; i < 1'000'000; ++i)
+        content += std::to_string(i) + "/name-" + std::to_string(i) + "\n";
+    const TempFile file{"mapped_lines_benchmark.txt", content};
+
+    BENCHMARK("std::getline")
+    {
+        std::ifstream in{file.path()};
+        std::size_t total = 0;
+        for (std::string line; std::getline(in, line);)
+            total += split(line).second.size();
+        return total;
+    };
+
+    BENCHMARK("mapped_lines")
+    {
+        std::size_t total = 0;
+        for (std::string_view line : rng::mapped_lines(file.path()))
+            total += split(line).second.size();
+        return total;
+    };
+}
@@ -0,0 +1,203 @@
+#ifndef MAPPED_LINES_HPP
+#define MAPPED_LINES_HPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RNG_HAS_MMAP 1
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace rng
+{
+    // read-only view of a whole file - mmap-ed where available, read into memory otherwise
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::filesystem::path& path)
+        {
+#ifdef RNG_HAS_MMAP
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd == -1)
+                throw std::system_error{errno, std::generic_category(), "cannot open " + path.string()};
+
+            struct stat info{};
+            if (::fstat(fd, &info) == -1)
+            {
+                const int error = errno;
+                ::close(fd);
+                throw std::system_error{error, std::generic_category(), "cannot stat " + path.string()};
+            }
+
+            size_ = static_cast<std::size_t>(info.st_size);
+            if (size_ > 0) // mmap of an empty file fails
+            {
+                void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED)
+                {
+                    const int error = errno;
+                    ::close(fd);
+                    throw std::system_error{error, std::generic_category(), "cannot map " + path.string()};
+                }
+
+                ::madvise(address, size_, MADV_SEQUENTIAL); // only a hint - aggressive read-ahead, early page release
+                data_ = static_cast<const char*>(address);
+            }
+
+            ::close(fd); // the mapping keeps the file alive
+#else
+            std::ifstream in{path, std::ios::binary};
+            if (!in)
+                throw std::system_error{std::make_error_code(std::errc::no_such_file_or_directory), "cannot open " + path.string()};
+
+            std::ostringstream content;
+            content << in.rdbuf();
+            buffer_ = std::move(content).str();
+            data_ = buffer_.data();
+            size_ = buffer_.size();
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile()
+        {
+#ifdef RNG_HAS_MMAP
+            if (data_)
+                ::munmap(const_cast<char*>(data_), size_);
+#endif
+        }
+
+        std::string_view content() const noexcept
+        {
+            return {data_, size_};
+        }
+
+    private:
+        const char* data_ = nullptr;
+        std::size_t size_ = 0;
+#ifndef RNG_HAS_MMAP
+        std::string buffer_;
+#endif
+    };
+
+    // lines of a text as string_views without the '\n' - a trailing '\n' does not start another line;
+    // the end of a line is found with memchr, which libc implements with SIMD
+    class LinesView : public std::ranges::view_interface<LinesView>
+    {
+    public:
+        class iterator
+        {
+        public:
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+            iterator() = default;
+
+            iterator(const char* first, const char* last) noexcept
+                : last_{last}
+            {
+                find_line(first);
+            }
+
+            std::string_view operator*() const noexcept
+            {
+                return line_;
+            }
+
+            iterator& operator++() noexcept
+            {
+                find_line(line_.data() + line_.size() + 1);
+                return *this;
+            }
+
+            iterator operator++(int) noexcept
+            {
+                auto tmp = *this;
+                ++*this;
+                return tmp;
+            }
+
+            bool operator==(const iterator& other) const noexcept
+            {
+                return line_.data() == other.line_.data();
+            }
+
+            bool operator==(std::default_sentinel_t) const noexcept
+            {
+                return line_.data() == nullptr;
+            }
+
+        private:
+            std::string_view line_;
+            const char* last_ = nullptr;
+
+            void find_line(const char* first) noexcept
+            {
+                if (first >= last_)
+                {
+                    line_ = {};
+                    return;
+                }
+
+                const auto* eol = static_cast<const char*>(std::memchr(first, '\n', static_cast<std::size_t>(last_ - first)));
+                line_ = std::string_view{first, eol ? eol : last_};
+            }
+        };
+
+        LinesView() = default;
+
+        explicit LinesView(std::string_view text, std::shared_ptr<const MappedFile> file = nullptr) noexcept
+            : text_{text}
+            , file_{std::move(file)}
+        {
+        }
+
+        iterator begin() const noexcept
+        {
+            return iterator{text_.data(), text_.data() + text_.size()};
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+    private:
+        std::string_view text_;
+        std::shared_ptr<const MappedFile> file_; // keeps the mapping alive as long as any copy of the view
+    };
+
+    inline LinesView lines(std::string_view text) noexcept
+    {
+        return LinesView{text};
+    }
+
+    // zero-copy lines of a file - string_views point into the mapping and stay valid while the view (or its copy) lives
+    inline LinesView mapped_lines(const std::filesystem::path& path)
+    {
+        auto file = std::make_shared<const MappedFile>(path);
+        const auto text = file->content();
+        return LinesView{text, std::move(file)};
+    }
+} // namespace rng
+
+#endif
@@ -0,0 +1,164 @@
+#include "par_chunks.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <thread_pool.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    auto square = [](long n) { return n * n; };
+    auto is_even = [](long x) { return x % 2 == 0; };
+
+    // compute-heavy kernel - the case parallel evaluation is for
+    auto heavy = [](long n) {
+        double x = static_cast<double>(n);
+        for (int i = 0; i < 16; ++i)
+            x = std::sqrt(x * x + 1.0);
+        return static_cast<long>(x);
+    };
+
+    template <typename R>
+    concept CanBeChunked = requires(R&& source) { rng::par_chunks(std::forward<R>(source), 2); };
+} // namespace
+
+TEST_CASE("par_chunks")
+{
+    std::vector data = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+    auto chunks = rng::par_chunks(data, 3);
+
+    REQUIRE(chunks.size() == 3);
+    REQUIRE(std::ranges::size(chunks[0]) == 4);
+    REQUIRE(std::ranges::size(chunks[1]) == 3);
+    REQUIRE(std::ranges::size(chunks[2]) == 3);
+    REQUIRE(chunks.front().begin() == data.begin());
+    REQUIRE(chunks.back().end() == data.end());
+
+    SECTION("no more chunks than elements")
+    {
+        REQUIRE(rng::par_chunks(data, 100).size() == data.size());
+    }
+
+    SECTION("temporaries only if the chunks do not dangle")
+    {
+        static_assert(CanBeChunked<std::vector<int>&>);
+        static_assert(!CanBeChunked<std::vector<int>>);
+        REQUIRE(rng::par_chunks(std::views::iota(0, 10), 2).size() == 2);
+    }
+}
+
+TEST_CASE("parallel_for_each - output merged in the order of the source")
+{
+    helpers::ThreadPool pool{4};
+    rng::ParallelPolicy policy{pool, 4, 100};
+
+    auto source = std::views::iota(1L, 100'001L);
+
+    SECTION("transform & filter into a back_inserter")
+    {
+        auto pipeline = std::views::transform(square) | std::views::filter(is_even);
+
+        std::vector<long> expected;
+        std::ranges::copy(source | pipeline, std::back_inserter(expected));
+
+        std::vector<long> result;
+        rng::parallel_for_each(source, pipeline, std::back_inserter(result), policy);
+
+        REQUIRE(result == expected);
+    }
+
+    SECTION("filter into a random access destination")
+    {
+        auto pipeline = std::views::filter(is_even) | std::views::transform(square);
+
+        std::vector<long> expected;
+        std::ranges::copy(source | pipeline, std::back_inserter(expected));
+
+        std::vector<long> result(expected.size());
+        auto last = rng::parallel_for_each(source, pipeline, result.begin(), policy);
+
+        REQUIRE(last == result.end());
+        REQUIRE(result == expected);
+    }
+
+    SECTION("sized pipeline writes in place")
+    {
+        std::vector<long> result(100'000);
+        auto last = rng::parallel_for_each(source, std::views::transform(square), result.begin(), policy);
+
+        REQUIRE(last == result.end());
+        REQUIRE(std::ranges::equal(result, source | std::views::transform(square)));
+    }
+
+    SECTION("sized pipeline evaluated once per element")
+    {
+        std::atomic<long> calls{0};
+        auto counted_square = std::views::transform([&calls](long n) {
+            ++calls;
+            return n * n;
+        });
+
+        std::vector<long> result(100'000);
+        rng::parallel_for_each(source, counted_square, result.begin(), policy);
+
+        REQUIRE(calls == 100'000);
+    }
+
+    SECTION("exception from a chunk is rethrown")
+    {
+        auto throwing = std::views::transform([](long n) {
+            if (n == 50'000)
+                throw std::runtime_error{"bad element"};
+            return n;
+        });
+
+        std::vector<long> result;
+        REQUIRE_THROWS_AS(rng::parallel_for_each(source, throwing, std::back_inserter(result), policy), std::runtime_error);
+    }
+
+    SECTION("nested call from a worker of the same pool")
+    {
+        helpers::ThreadPool single_thread{1};
+        const rng::ParallelPolicy nested_policy{single_thread, 4, 100};
+
+        std::promise<std::vector<long>> nested_result;
+        single_thread.submit([&] {
+            std::vector<long> result;
+            rng::parallel_for_each(source, std::views::transform(square), std::back_inserter(result), nested_policy);
+            nested_result.set_value(std::move(result));
+        });
+
+        REQUIRE(std::ranges::equal(nested_result.get_future().get(), source | std::views::transform(square)));
+    }
+}
+
+TEST_CASE("parallel_for_each - scaling of a compute-heavy transform", "[.][benchmark]")
+{
+    helpers::ThreadPool pool;
+    rng::ParallelPolicy policy{pool};
+
+    auto source = std::views::iota(0L, 10'000'000L);
+    auto pipeline = std::views::transform(heavy) | std::views::filter(is_even);
+
+    BENCHMARK("serial")
+    {
+        std::vector<long> result;
+        std::ranges::copy(source | pipeline, std::back_inserter(result));
+        return result.size();
+    };
+
+    BENCHMARK("parallel - " + std::to_string(pool.size()) + " threads")
+    {
+        std::vector<long> result;
+        rng::parallel_for_each(source, pipeline, std::back_inserter(result), policy);
+        return result.size();
+    };
+}
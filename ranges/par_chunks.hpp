@@ -0,0 +1,179 @@
+#ifndef PAR_CHUNKS_HPP
+#define PAR_CHUNKS_HPP
+
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <latch>
+#include <mutex>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+namespace rng
+{
+    struct ParallelPolicy
+    {
+        helpers::ThreadPool& pool;
+        std::size_t chunks_per_thread = 4; // more chunks than threads balances uneven filters
+        std::size_t min_chunk_size = 4096; // smaller inputs are not worth the hand-off to the pool
+    };
+
+    // random access range with a size known in O(1) - use iota(first, last) rather than iota(first) | take(n)
+    template <typename R>
+    concept ChunkableRange = std::ranges::random_access_range<R>
+        && (std::ranges::sized_range<R> || std::sized_sentinel_for<std::ranges::sentinel_t<R>, std::ranges::iterator_t<R>>);
+
+    // splits the source into n contiguous subranges of (almost) equal size - the source must outlive them,
+    // so owning rvalues (a temporary vector) are rejected
+    template <ChunkableRange R>
+        requires std::ranges::borrowed_range<R>
+    auto par_chunks(R&& source, std::size_t n)
+    {
+        using Chunk = std::ranges::subrange<std::ranges::iterator_t<R>>;
+
+        const auto size = static_cast<std::size_t>(std::ranges::distance(source));
+        n = std::clamp<std::size_t>(n, 1, std::max<std::size_t>(1, size));
+
+        std::vector<Chunk> chunks;
+        chunks.reserve(n);
+
+        auto first = std::ranges::begin(source);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const auto chunk_size = static_cast<std::ranges::range_difference_t<R>>(size / n + (i < size % n ? 1 : 0));
+            chunks.emplace_back(first, first + chunk_size);
+            first += chunk_size;
+        }
+
+        return chunks;
+    }
+
+    namespace detail
+    {
+        // runs task(i) for i in [0, count) on the pool; the first exception is rethrown after all tasks finish;
+        // called from a worker of the same pool (nested parallel algorithms) the tasks run inline - waiting for
+        // jobs queued behind the caller would deadlock a pool whose workers all wait
+        template <typename Task>
+        void run_on_pool(helpers::ThreadPool& pool, std::size_t count, Task task)
+        {
+            std::mutex mtx_error;
+            std::exception_ptr error;
+
+            if (pool.is_worker())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    try
+                    {
+                        task(i);
+                    }
+                    catch (...)
+                    {
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+
+                if (error)
+                    std::rethrow_exception(error);
+                return;
+            }
+
+            std::latch done{static_cast<std::ptrdiff_t>(count)};
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                pool.submit([&, i] {
+                    try
+                    {
+                        task(i);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard lk{mtx_error};
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                    done.count_down();
+                });
+            }
+
+            done.wait();
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    } // namespace detail
+
+    // evaluates `chunk | pipeline` for chunks of the source on the thread pool and writes the results
+    // to the destination in the order of the source - the pipeline must be element-wise (transform, filter, ...);
+    // views that look at the whole range (reverse, take, drop) belong to the source or after the merge
+    template <ChunkableRange R, typename Pipeline, std::weakly_incrementable Out>
+        requires std::ranges::input_range<std::invoke_result_t<Pipeline&, std::ranges::subrange<std::ranges::iterator_t<R>>>>
+    Out parallel_for_each(R&& source, Pipeline pipeline, Out destination, const ParallelPolicy& policy)
+    {
+        using ChunkView = std::invoke_result_t<Pipeline&, std::ranges::subrange<std::ranges::iterator_t<R>>>;
+        using Value = std::ranges::range_value_t<ChunkView>;
+
+        const auto size = static_cast<std::size_t>(std::ranges::distance(source));
+        const std::size_t max_chunks = std::max<std::size_t>(1, size / std::max<std::size_t>(1, policy.min_chunk_size));
+        const auto chunks = par_chunks(source, std::min(policy.pool.size() * policy.chunks_per_thread, max_chunks));
+
+        if (chunks.size() == 1)
+            return std::ranges::copy(pipeline(chunks.front()), std::move(destination)).out;
+
+        // element-wise pipeline without filters - every chunk writes straight to its place in the destination
+        if constexpr (std::random_access_iterator<Out> && std::ranges::sized_range<ChunkView>)
+        {
+            // one view per chunk - sized before the copy, evaluated only by the copy
+            std::vector<ChunkView> views;
+            views.reserve(chunks.size());
+            std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                views.push_back(pipeline(chunks[i]));
+                offsets[i + 1] = offsets[i] + static_cast<std::size_t>(std::ranges::size(views.back()));
+            }
+
+            detail::run_on_pool(policy.pool, chunks.size(), [&](std::size_t i) {
+                std::ranges::copy(views[i], destination + static_cast<std::iter_difference_t<Out>>(offsets[i]));
+            });
+
+            return destination + static_cast<std::iter_difference_t<Out>>(offsets.back());
+        }
+        else
+        {
+            std::vector<std::vector<Value>> buffers(chunks.size());
+            detail::run_on_pool(policy.pool, chunks.size(), [&](std::size_t i) {
+                buffers[i].reserve(static_cast<std::size_t>(std::ranges::size(chunks[i])));
+                std::ranges::copy(pipeline(chunks[i]), std::back_inserter(buffers[i]));
+            });
+
+            if constexpr (std::random_access_iterator<Out>)
+            {
+                std::vector<std::size_t> offsets(buffers.size() + 1, 0);
+                for (std::size_t i = 0; i < buffers.size(); ++i)
+                    offsets[i + 1] = offsets[i] + buffers[i].size();
+
+                detail::run_on_pool(policy.pool, buffers.size(), [&](std::size_t i) {
+                    std::ranges::move(buffers[i], destination + static_cast<std::iter_difference_t<Out>>(offsets[i]));
+                });
+
+                return destination + static_cast<std::iter_difference_t<Out>>(offsets.back());
+            }
+            else
+            {
+                for (auto& buffer : buffers)
+                    destination = std::ranges::move(buffer, std::move(destination)).out;
+
+                return destination;
+            }
+        }
+    }
+} // namespace rng
+
+#endif
@@ -0,0 +1,125 @@
+#include "parallel_sort.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Person
+    {
+        int id;
+        std::string name;
+
+        bool operator==(const Person&) const = default;
+    };
+
+    std::vector<Person> create_people(std::size_t count)
+    {
+        const std::vector<std::string> names = {"Jan", "Adam", "Zenon", "Ewa", "Anna"};
+
+        std::mt19937 rnd{42};
+        std::vector<Person> people;
+        for (std::size_t i = 0; i < count; ++i)
+            people.push_back(Person{static_cast<int>(i), names[rnd() % names.size()]});
+        return people;
+    }
+} // namespace
+
+TEST_CASE("parallel_sort")
+{
+    helpers::ThreadPool pool{4};
+    rng::ParallelPolicy policy{pool, 4, 100};
+
+    SECTION("the same result as std::ranges::sort")
+    {
+        auto data = helpers::create_numeric_dataset<10'000>(42, -1000, 1000);
+        auto expected = data;
+        std::ranges::sort(expected, std::greater{});
+
+        REQUIRE(rng::parallel_sort(policy, data, std::greater{}) == data.end());
+        REQUIRE(data == expected);
+    }
+
+    SECTION("projection")
+    {
+        std::vector<std::string> words;
+        for (int i = 0; i < 5'000; ++i)
+            words.push_back(std::string(static_cast<std::size_t>(i * 7919 % 13), 'a' + static_cast<char>(i % 26)));
+
+        rng::parallel_sort(policy, words, std::less{}, &std::string::size);
+
+        REQUIRE(std::ranges::is_sorted(words, std::less{}, &std::string::size));
+    }
+
+    SECTION("stable variant keeps the order of equivalent elements")
+    {
+        auto people = create_people(10'001); // runs of unequal size
+        auto expected = people;
+        std::ranges::stable_sort(expected, std::less{}, &Person::name);
+
+        rng::parallel_stable_sort(policy, people, std::less{}, &Person::name);
+
+        REQUIRE(people == expected);
+    }
+
+    SECTION("odd number of runs")
+    {
+        helpers::ThreadPool pool3{3};
+        auto people = create_people(1'000);
+        auto expected = people;
+        std::ranges::stable_sort(expected, std::greater{}, &Person::name);
+
+        rng::parallel_stable_sort(rng::ParallelPolicy{pool3, 4, 10}, people.begin(), people.end(), std::greater{}, &Person::name);
+
+        REQUIRE(people == expected);
+    }
+
+    SECTION("short ranges are sorted serially")
+    {
+        std::vector data = {5, 3, 1, 4, 2};
+        rng::parallel_sort(policy, data);
+        REQUIRE(data == std::vector{1, 2, 3, 4, 5});
+
+        std::vector<int> empty;
+        REQUIRE(rng::parallel_sort(policy, empty) == empty.end());
+    }
+}
+
+TEST_CASE("parallel_sort vs std::ranges::sort", "[.][benchmark]")
+{
+    helpers::ThreadPool pool;
+    rng::ParallelPolicy policy{pool};
+
+    std::vector<int> data(10'000'000);
+    std::ranges::generate(data, std::mt19937{42});
+
+    BENCHMARK("std::ranges::sort")
+    {
+        auto copy = data;
+        std::ranges::sort(copy);
+        return copy.front();
+    };
+
+    BENCHMARK("parallel_sort - " + std::to_string(pool.size()) + " threads")
+    {
+        auto copy = data;
+        rng::parallel_sort(policy, copy);
+        return copy.front();
+    };
+
+    BENCHMARK("parallel_stable_sort - " + std::to_string(pool.size()) + " threads")
+    {
+        auto copy = data;
+        rng::parallel_stable_sort(policy, copy);
+        return copy.front();
+    };
+}
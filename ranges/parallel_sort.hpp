@@ -0,0 +1,242 @@
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include "par_chunks.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rng
+{
+    namespace detail
+    {
+        template <bool Stable, typename I, typename Comp, typename Proj>
+        void serial_sort(I first, I last, Comp& comp, Proj& proj)
+        {
+            if constexpr (Stable)
+                std::ranges::stable_sort(first, last, std::ref(comp), std::ref(proj));
+            else
+                std::ranges::sort(first, last, std::ref(comp), std::ref(proj));
+        }
+
+        template <typename It>
+        It advance_by(It it, std::size_t n)
+        {
+            return it + static_cast<std::iter_difference_t<It>>(n);
+        }
+
+        // number of elements of a (of size m) among the first k elements of merge(a, b) - "merge path" split;
+        // elements of a go first on ties, as in std::ranges::merge
+        template <typename It, typename Comp, typename Proj>
+        std::size_t co_rank(std::size_t k, It a, std::size_t m, It b, std::size_t n, Comp& comp, Proj& proj)
+        {
+            std::size_t low = k > n ? k - n : 0;
+            std::size_t high = std::min(k, m);
+            while (low < high)
+            {
+                const std::size_t i = low + (high - low) / 2;
+                const std::size_t j = k - i;
+                if (j > 0 && !std::invoke(comp, std::invoke(proj, *advance_by(b, j - 1)), std::invoke(proj, *advance_by(a, i))))
+                    low = i + 1; // a[i] is not greater than b[j - 1] - it belongs before position k
+                else
+                    high = i;
+            }
+            return low;
+        }
+
+        // storage for the merge passes - filled by moving the sorted runs in parallel
+        template <typename T>
+        class MergeBuffer
+        {
+        public:
+            explicit MergeBuffer(std::size_t size)
+                : data_{std::allocator<T>{}.allocate(size)}
+                , size_{size}
+            {
+            }
+
+            MergeBuffer(const MergeBuffer&) = delete;
+            MergeBuffer& operator=(const MergeBuffer&) = delete;
+
+            ~MergeBuffer()
+            {
+                if (constructed_)
+                    std::destroy_n(data_, size_);
+                std::allocator<T>{}.deallocate(data_, size_);
+            }
+
+            T* data() const noexcept
+            {
+                return data_;
+            }
+
+            void set_constructed() noexcept
+            {
+                constructed_ = true;
+            }
+
+        private:
+            T* data_;
+            std::size_t size_;
+            bool constructed_ = false;
+        };
+
+        // part of the merge of two adjacent runs - [left_first, left_last) and [right_first, right_last) of the source
+        // go to the destination at output
+        struct MergeTask
+        {
+            std::size_t left_first;
+            std::size_t left_last;
+            std::size_t right_first;
+            std::size_t right_last;
+            std::size_t output;
+        };
+
+        // one pass merging pairs of adjacent runs - the output of every pair is split into parts of similar size,
+        // so the last passes (few long runs) use all the threads as well
+        template <typename Src, typename Dst, typename Comp, typename Proj>
+        void merge_pass(const ParallelPolicy& policy, Src source, Dst destination, std::vector<std::size_t>& bounds, Comp& comp, Proj& proj)
+        {
+            const std::size_t size = bounds.back();
+            const std::size_t parts = std::max<std::size_t>(1, policy.pool.size() * policy.chunks_per_thread);
+
+            // splits are found before any element is moved out of the source
+            std::vector<MergeTask> tasks;
+            std::vector<std::size_t> merged_bounds;
+            for (std::size_t r = 0; r + 1 < bounds.size(); r += 2)
+            {
+                const std::size_t first = bounds[r];
+                const std::size_t middle = bounds[r + 1];
+                const std::size_t last = r + 2 < bounds.size() ? bounds[r + 2] : middle; // an odd run is moved as it is
+                const std::size_t pair_parts = std::max<std::size_t>(1, parts * (last - first) / size);
+
+                const auto left = advance_by(source, first);
+                const auto right = advance_by(source, middle);
+                std::size_t i = 0;
+                for (std::size_t p = 1; p <= pair_parts; ++p)
+                {
+                    const std::size_t k = (last - first) * p / pair_parts;
+                    const std::size_t i_next = co_rank(k, left, middle - first, right, last - middle, comp, proj);
+                    const std::size_t k_prev = (last - first) * (p - 1) / pair_parts;
+                    tasks.push_back({first + i, first + i_next, middle + (k_prev - i), middle + (k - i_next), first + k_prev});
+                    i = i_next;
+                }
+
+                merged_bounds.push_back(first);
+            }
+            merged_bounds.push_back(size);
+
+            run_on_pool(policy.pool, tasks.size(), [&](std::size_t t) {
+                const MergeTask& task = tasks[t];
+                std::ranges::merge(std::make_move_iterator(advance_by(source, task.left_first)), std::make_move_iterator(advance_by(source, task.left_last)),
+                    std::make_move_iterator(advance_by(source, task.right_first)), std::make_move_iterator(advance_by(source, task.right_last)),
+                    advance_by(destination, task.output), std::ref(comp), std::ref(proj), std::ref(proj));
+            });
+
+            bounds = std::move(merged_bounds);
+        }
+
+        // runs sorted in parallel, then merged pairwise between the range and a buffer
+        template <bool Stable, typename I, typename Comp, typename Proj>
+        void parallel_merge_sort(const ParallelPolicy& policy, I first, I last, Comp& comp, Proj& proj)
+        {
+            using Value = std::iter_value_t<I>;
+
+            const auto size = static_cast<std::size_t>(last - first);
+            const std::size_t runs = std::min(policy.pool.size(), size / std::max<std::size_t>(1, policy.min_chunk_size));
+
+            // a throwing move would leave the buffer partly constructed
+            if constexpr (!std::is_nothrow_move_constructible_v<Value>)
+            {
+                serial_sort<Stable>(first, last, comp, proj);
+                return;
+            }
+            else
+            {
+                if (runs < 2)
+                {
+                    serial_sort<Stable>(first, last, comp, proj);
+                    return;
+                }
+
+                std::vector<std::size_t> bounds(runs + 1);
+                for (std::size_t r = 0; r <= runs; ++r)
+                    bounds[r] = size * r / runs;
+
+                run_on_pool(policy.pool, runs, [&](std::size_t r) {
+                    serial_sort<Stable>(advance_by(first, bounds[r]), advance_by(first, bounds[r + 1]), comp, proj);
+                });
+
+                MergeBuffer<Value> buffer{size};
+                run_on_pool(policy.pool, runs, [&](std::size_t r) {
+                    std::uninitialized_move(advance_by(first, bounds[r]), advance_by(first, bounds[r + 1]), buffer.data() + bounds[r]);
+                });
+                buffer.set_constructed();
+
+                bool in_buffer = true;
+                while (bounds.size() > 2)
+                {
+                    if (in_buffer)
+                        merge_pass(policy, buffer.data(), first, bounds, comp, proj);
+                    else
+                        merge_pass(policy, first, buffer.data(), bounds, comp, proj);
+                    in_buffer = !in_buffer;
+                }
+
+                if (in_buffer)
+                {
+                    const auto parts = par_chunks(std::ranges::subrange{buffer.data(), buffer.data() + size}, policy.pool.size());
+                    run_on_pool(policy.pool, parts.size(), [&](std::size_t p) {
+                        std::ranges::move(parts[p], advance_by(first, static_cast<std::size_t>(parts[p].begin() - buffer.data())));
+                    });
+                }
+            }
+        }
+    } // namespace detail
+
+    // sorts on the thread pool with the comparator and projection of std::ranges::sort:
+    //   rng::parallel_sort(policy, people, std::less{}, &Person::name);
+    // runs of the range are sorted in parallel and merged with parallel merge passes;
+    // ranges shorter than 2 * policy.min_chunk_size are sorted serially
+    template <std::random_access_iterator I, std::sentinel_for<I> S, typename Comp = std::ranges::less, typename Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    I parallel_sort(const ParallelPolicy& policy, I first, S last, Comp comp = {}, Proj proj = {})
+    {
+        const I end = std::ranges::next(first, last);
+        detail::parallel_merge_sort<false>(policy, first, end, comp, proj);
+        return end;
+    }
+
+    template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    std::ranges::borrowed_iterator_t<R> parallel_sort(const ParallelPolicy& policy, R&& range, Comp comp = {}, Proj proj = {})
+    {
+        return rng::parallel_sort(policy, std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+    }
+
+    // equivalent elements keep their order, as with std::ranges::stable_sort
+    template <std::random_access_iterator I, std::sentinel_for<I> S, typename Comp = std::ranges::less, typename Proj = std::identity>
+        requires std::sortable<I, Comp, Proj>
+    I parallel_stable_sort(const ParallelPolicy& policy, I first, S last, Comp comp = {}, Proj proj = {})
+    {
+        const I end = std::ranges::next(first, last);
+        detail::parallel_merge_sort<true>(policy, first, end, comp, proj);
+        return end;
+    }
+
+    template <std::ranges::random_access_range R, typename Comp = std::ranges::less, typename Proj = std::identity>
+        requires std::sortable<std::ranges::iterator_t<R>, Comp, Proj>
+    std::ranges::borrowed_iterator_t<R> parallel_stable_sort(const ParallelPolicy& policy, R&& range, Comp comp = {}, Proj proj = {})
+    {
+        return rng::parallel_stable_sort(policy, std::ranges::begin(range), std::ranges::end(range), std::move(comp), std::move(proj));
+    }
+} // namespace rng
+
+#endif
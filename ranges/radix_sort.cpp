@@ -0,0 +1,198 @@
+#include "radix_sort.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory_resource>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    struct Person
+    {
+        int id;
+        std::string name;
+        double salary;
+
+        bool operator==(const Person&) const = default;
+    };
+
+    std::vector<Person> create_people(std::size_t count)
+    {
+        const std::vector<std::string> names = {"Jan", "Adam", "Zenon", "Ewa", "Anna", "", "Jan Kowalski", "Adamczyk"};
+
+        std::mt19937 rnd{42};
+        std::vector<Person> people;
+        for (std::size_t i = 0; i < count; ++i)
+            people.push_back(Person{static_cast<int>(rnd() % 100) - 50, names[rnd() % names.size()], static_cast<double>(rnd() % 1000) / 8 - 60});
+        return people;
+    }
+
+    template <typename T>
+    std::vector<T> create_values(std::size_t count, std::uint32_t seed = 42)
+    {
+        std::mt19937_64 rnd{seed};
+        std::vector<T> values(count);
+        std::ranges::generate(values, [&] { return static_cast<T>(rnd()); });
+        return values;
+    }
+
+    template <typename R, typename Proj = std::identity>
+    void check_like_stable_sort(R data, Proj proj = {})
+    {
+        auto expected = data;
+        std::ranges::stable_sort(expected, std::less{}, proj);
+
+        rng::radix_sort(data, proj);
+
+        REQUIRE(data == expected);
+    }
+} // namespace
+
+TEST_CASE("radix_sort - integral keys")
+{
+    check_like_stable_sort(create_values<int>(10'000));
+    check_like_stable_sort(create_values<std::uint32_t>(10'000));
+    check_like_stable_sort(create_values<std::int64_t>(10'000));
+    check_like_stable_sort(create_values<std::int8_t>(1'000));
+    check_like_stable_sort(create_values<std::uint16_t>(1'000));
+    check_like_stable_sort(std::vector{std::numeric_limits<int>::max(), -1, 0, std::numeric_limits<int>::min(), 1});
+
+    SECTION("dataset from helpers")
+    {
+        auto data = helpers::create_numeric_dataset<1'000>(42, -1'000, 1'000);
+        auto expected = data;
+        std::ranges::sort(expected);
+
+        REQUIRE(rng::radix_sort(data) == data.end());
+        REQUIRE(data == expected);
+    }
+}
+
+TEST_CASE("radix_sort - floating point keys")
+{
+    check_like_stable_sort(std::vector{2.5, -0.0, 0.0, -1.5, 1e300, -1e-300, 0.0, -0.0, -std::numeric_limits<double>::infinity()});
+    check_like_stable_sort(std::vector{1.5f, -0.0f, 0.0f, -2.25f, std::numeric_limits<float>::max(), std::numeric_limits<float>::lowest()});
+
+    SECTION("zeros of both signs keep their order")
+    {
+        std::vector zeros = {0.0, -0.0, 1.0, -0.0, 0.0};
+        rng::radix_sort(zeros);
+
+        auto signs = zeros | std::views::transform([](double x) { return std::signbit(x); });
+        REQUIRE(std::ranges::equal(signs, std::vector{false, true, true, false, false}));
+    }
+
+    auto values = create_values<std::int32_t>(10'000);
+    std::vector<float> floats(values.begin(), values.end());
+    for (auto& f : floats)
+        f /= 1000;
+    check_like_stable_sort(floats);
+}
+
+TEST_CASE("radix_sort - string keys")
+{
+    check_like_stable_sort(std::vector<std::string>{"one", "two", "three", "", "t", "tw", "twoo", "\xff", "a"});
+
+    std::vector<std::string> words;
+    for (auto value : create_values<std::uint32_t>(5'000))
+        words.push_back("prefix-" + std::to_string(value % 997));
+    check_like_stable_sort(words);
+
+    std::vector<std::string_view> views(words.begin(), words.end());
+    check_like_stable_sort(views);
+}
+
+TEST_CASE("radix_sort - deep shared prefixes")
+{
+    SECTION("a, aa, aaa, ...")
+    {
+        std::vector<std::string> prefixes;
+        for (std::size_t length = 1; length <= 2'000; ++length)
+            prefixes.push_back(std::string(length, 'a'));
+        std::ranges::shuffle(prefixes, std::mt19937{42});
+
+        check_like_stable_sort(prefixes);
+    }
+
+    SECTION("long common prefix, branching at every depth")
+    {
+        std::vector<std::string> words;
+        const std::string prefix(10'000, 'x');
+        for (std::size_t length = 0; length < 2'000; ++length)
+        {
+            words.push_back(prefix + std::string(length, 'b') + 'a');
+            words.push_back(prefix + std::string(length, 'b') + 'c');
+        }
+        std::ranges::shuffle(words, std::mt19937{7});
+
+        check_like_stable_sort(words);
+    }
+}
+
+TEST_CASE("radix_sort - projections keep the order of equal keys")
+{
+    const auto people = create_people(2'000);
+
+    check_like_stable_sort(people, &Person::id);
+    check_like_stable_sort(people, &Person::name);
+    check_like_stable_sort(people, &Person::salary);
+}
+
+TEST_CASE("radix_sort - scratch memory from the allocator")
+{
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::polymorphic_allocator<std::byte> allocator{&arena};
+
+    std::vector<std::string> words = {"c", "a", "b"};
+    rng::radix_sort(words, std::identity{}, allocator);
+    REQUIRE(words == std::vector<std::string>{"a", "b", "c"});
+
+    std::vector<int> data = {3, -1, 2};
+    rng::radix_sort(data, std::identity{}, allocator);
+    REQUIRE(data == std::vector{-1, 2, 3});
+}
+
+TEST_CASE("radix_sort vs std::ranges::sort", "[.][benchmark]")
+{
+    const auto keys = create_values<std::uint32_t>(4'000'000);
+    const auto people = create_people(1'000'000);
+
+    BENCHMARK("std::ranges::sort - 32-bit keys")
+    {
+        auto data = keys;
+        std::ranges::sort(data);
+        return data.front();
+    };
+
+    BENCHMARK("radix_sort - 32-bit keys")
+    {
+        auto data = keys;
+        rng::radix_sort(data);
+        return data.front();
+    };
+
+    BENCHMARK("std::ranges::stable_sort - by name")
+    {
+        auto data = people;
+        std::ranges::stable_sort(data, std::less{}, &Person::name);
+        return data.front().id;
+    };
+
+    BENCHMARK("radix_sort - by name")
+    {
+        auto data = people;
+        rng::radix_sort(data, &Person::name);
+        return data.front().id;
+    };
+}
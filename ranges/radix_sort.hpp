@@ -0,0 +1,237 @@
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rng
+{
+    namespace detail
+    {
+        template <typename K>
+        concept RadixIntegral = std::integral<K> && !std::same_as<K, bool>;
+
+        template <typename K>
+        concept RadixFloatingPoint = std::same_as<K, float> || std::same_as<K, double>;
+
+        // string keys are sorted by reference - a projection returning std::string by value would dangle
+        template <typename K>
+        concept RadixString = std::same_as<std::remove_cvref_t<K>, std::string_view>
+            || (std::is_lvalue_reference_v<K> && std::same_as<std::remove_cvref_t<K>, std::string>);
+
+        template <typename K>
+        concept RadixKey = RadixIntegral<std::remove_cvref_t<K>> || RadixFloatingPoint<std::remove_cvref_t<K>> || RadixString<K>;
+
+        template <typename Allocator, typename T>
+        using rebind_alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+        // unsigned image of a key with the same order as operator<
+        template <typename K>
+        auto to_radix_key(K key) noexcept
+        {
+            if constexpr (RadixFloatingPoint<K>)
+            {
+                using U = std::conditional_t<sizeof(K) == 4, std::uint32_t, std::uint64_t>;
+                constexpr U sign = U{1} << (sizeof(U) * 8 - 1);
+
+                if (key == K{0})
+                    key = K{0}; // -0.0 and 0.0 are equivalent for operator< - and keep their order in a stable sort
+                const U bits = std::bit_cast<U>(key);
+                return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+            }
+            else
+            {
+                using U = std::make_unsigned_t<K>;
+                if constexpr (std::is_signed_v<K>)
+                    return static_cast<U>(static_cast<U>(key) ^ (U{1} << (sizeof(U) * 8 - 1)));
+                else
+                    return static_cast<U>(key);
+            }
+        }
+
+        // LSD radix sort - one counting pass over all the digits, then a stable scatter per byte;
+        // bytes equal in all the keys are skipped; the elements start in the buffer and end in the range
+        template <typename I, typename T, typename KeyOf>
+        void lsd_radix_sort(I first, std::size_t size, T* buffer, KeyOf key_of)
+        {
+            using U = decltype(key_of(*buffer));
+            constexpr std::size_t digits = sizeof(U);
+
+            std::array<std::array<std::size_t, 256>, digits> counts{};
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                const U key = key_of(buffer[i]);
+                for (std::size_t d = 0; d < digits; ++d)
+                    ++counts[d][(key >> (8 * d)) & 0xFF];
+            }
+
+            auto scatter = [&](auto source, auto destination, std::size_t d) {
+                std::array<std::size_t, 256> offsets;
+                std::exclusive_scan(counts[d].begin(), counts[d].end(), offsets.begin(), std::size_t{0});
+
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    auto&& item = source[static_cast<std::ptrdiff_t>(i)];
+                    const std::size_t digit = (key_of(item) >> (8 * d)) & 0xFF;
+                    destination[static_cast<std::ptrdiff_t>(offsets[digit]++)] = std::move(item);
+                }
+            };
+
+            const U probe = key_of(buffer[0]);
+            bool in_buffer = true;
+            for (std::size_t d = 0; d < digits; ++d)
+            {
+                if (counts[d][(probe >> (8 * d)) & 0xFF] == size)
+                    continue;
+
+                if (in_buffer)
+                    scatter(buffer, first, d);
+                else
+                    scatter(first, buffer, d);
+                in_buffer = !in_buffer;
+            }
+
+            if (in_buffer)
+                std::ranges::move(buffer, buffer + size, first);
+        }
+
+        struct StringEntry
+        {
+            std::string_view key;
+            std::size_t index;
+        };
+
+        // MSD radix sort of string keys - strings ending at the depth go first, buckets shorter than
+        // small_bucket are finished with stable_sort; the largest bucket is sorted by the loop, the others
+        // (at most half of the entries each) recursively, so the recursion depth is O(log size) however long
+        // the common prefixes are - max_recursion is a safety net
+        inline void msd_radix_sort(StringEntry* data, StringEntry* scratch, std::size_t size, std::size_t depth, std::size_t recursion = 0)
+        {
+            constexpr std::size_t small_bucket = 32;
+            constexpr std::size_t max_recursion = 48;
+
+            while (true)
+            {
+                if (size < small_bucket || recursion > max_recursion)
+                {
+                    std::stable_sort(data, data + size, [](const StringEntry& a, const StringEntry& b) { return a.key < b.key; });
+                    return;
+                }
+
+                auto bucket = [depth](const StringEntry& entry) -> std::size_t {
+                    return depth < entry.key.size() ? static_cast<unsigned char>(entry.key[depth]) + 1 : 0;
+                };
+
+                std::array<std::size_t, 257> counts{};
+                for (std::size_t i = 0; i < size; ++i)
+                    ++counts[bucket(data[i])];
+
+                // common prefix - no scatter needed
+                if (const std::size_t common = bucket(data[0]); common != 0 && counts[common] == size)
+                {
+                    ++depth;
+                    continue;
+                }
+
+                std::array<std::size_t, 257> offsets;
+                std::exclusive_scan(counts.begin(), counts.end(), offsets.begin(), std::size_t{0});
+                const std::array<std::size_t, 257> starts = offsets;
+
+                for (std::size_t i = 0; i < size; ++i)
+                    scratch[offsets[bucket(data[i])]++] = data[i];
+                std::copy_n(scratch, size, data);
+
+                std::size_t largest = 0;
+                for (std::size_t b = 1; b < 257; ++b)
+                {
+                    if (counts[b] > counts[largest])
+                        largest = b;
+                }
+
+                for (std::size_t b = 1; b < 257; ++b)
+                {
+                    if (b != largest && counts[b] > 1)
+                        msd_radix_sort(data + starts[b], scratch + starts[b], counts[b], depth + 1, recursion + 1);
+                }
+
+                if (largest == 0 || counts[largest] < 2)
+                    return;
+
+                data += starts[largest];
+                scratch += starts[largest];
+                size = counts[largest];
+                ++depth;
+            }
+        }
+    } // namespace detail
+
+    // radix sort by a projected key - the same result as std::ranges::stable_sort(range, std::less{}, proj):
+    //  - integers and floats (by the bits of their total order) - LSD, one pass per byte
+    //  - std::string / std::string_view - MSD over (key, index) entries, then one permutation of the elements
+    // scratch memory is taken from the allocator (rebound as needed)
+    //   rng::radix_sort(people, &Person::id);
+    //   rng::radix_sort(words, std::identity{}, std::pmr::polymorphic_allocator<>{&arena});
+    template <std::ranges::random_access_range R, typename Proj = std::identity, typename Allocator = std::allocator<std::byte>>
+        requires std::ranges::sized_range<R> && std::permutable<std::ranges::iterator_t<R>>
+        && detail::RadixKey<std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>>
+    std::ranges::borrowed_iterator_t<R> radix_sort(R&& range, Proj proj = {}, const Allocator& allocator = {})
+    {
+        using Value = std::ranges::range_value_t<R>;
+        using Key = std::invoke_result_t<Proj&, std::ranges::range_reference_t<R>>;
+
+        const auto first = std::ranges::begin(range);
+        const auto size = static_cast<std::size_t>(std::ranges::size(range));
+        const auto last = first + static_cast<std::ranges::range_difference_t<R>>(size);
+        if (size < 2)
+            return last;
+
+        if constexpr (detail::RadixString<Key>)
+        {
+            using EntryAllocator = detail::rebind_alloc_t<Allocator, detail::StringEntry>;
+
+            const EntryAllocator entry_allocator(allocator);
+            std::vector<detail::StringEntry, EntryAllocator> entries(entry_allocator);
+            entries.reserve(size);
+            for (std::size_t i = 0; i < size; ++i)
+                entries.push_back({std::string_view{std::invoke(proj, first[static_cast<std::ptrdiff_t>(i)])}, i});
+
+            std::vector<detail::StringEntry, EntryAllocator> scratch(size, entry_allocator);
+            detail::msd_radix_sort(entries.data(), scratch.data(), size, 0);
+
+            using ValueAllocator = detail::rebind_alloc_t<Allocator, Value>;
+            const ValueAllocator value_allocator(allocator);
+            std::vector<Value, ValueAllocator> sorted(value_allocator);
+            sorted.reserve(size);
+            for (const auto& entry : entries)
+                sorted.push_back(std::ranges::iter_move(first + static_cast<std::ptrdiff_t>(entry.index)));
+            std::ranges::move(sorted, first);
+        }
+        else
+        {
+            using ValueAllocator = detail::rebind_alloc_t<Allocator, Value>;
+
+            std::vector<Value, ValueAllocator> buffer(std::make_move_iterator(first), std::make_move_iterator(last), ValueAllocator(allocator));
+            detail::lsd_radix_sort(first, size, buffer.data(), [&proj](const Value& item) {
+                return detail::to_radix_key(static_cast<std::remove_cvref_t<Key>>(std::invoke(proj, item)));
+            });
+        }
+
+        return last;
+    }
+} // namespace rng
+
+#endif
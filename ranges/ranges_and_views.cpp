@@ -1,3 +1,5 @@
+#include "sentinel_search.hpp"
+
 #include <catch2/catch_test_macros.hpp>
 #include <helpers.hpp>
 #include <iostream>
@@ -56,14 +58,7 @@ TEST_CASE("ranges", "[ranges]")
     }
 }
 
-template <auto Value>
-struct EndValue
-{
-    bool operator==(auto it) const
-    {
-        return *it == Value;
-    }
-};
+using rng::EndValue;
 
 TEST_CASE("sentinels", "[ranges]")
 {
@@ -71,8 +66,9 @@ TEST_CASE("sentinels", "[ranges]")
     std::ranges::sort(data.begin(), EndValue<42>{});
     helpers::print(data, "data");
 
-    auto pos = std::ranges::find(data.begin(), std::unreachable_sentinel, 42);
+    auto pos = rng::find(data.begin(), std::unreachable_sentinel, 42); // scanned in SIMD blocks
     REQUIRE(*pos == 42);
+    REQUIRE(rng::find(data.begin(), EndValue<42>{}, 5) != pos);
 
     char txt[] = { 'a', 'b', 'c', '\0', 'e', 'f' };
     std::ranges::sort(std::ranges::begin(txt), EndValue<'\0'>{}, std::greater{});
@@ -0,0 +1,156 @@
+#include "sentinel_search.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // every terminator position and every alignment of the first element within a SIMD block
+    template <typename T>
+    void check_against_std_ranges()
+    {
+        constexpr T terminator = 0;
+        constexpr T value = 7;
+
+        for (std::size_t offset = 0; offset < 8; ++offset)
+            for (std::size_t length = 0; length < 70; ++length)
+            {
+                std::vector<T> buffer(offset + length + 1, T{3});
+                for (std::size_t i = offset; i < buffer.size(); i += 3)
+                    buffer[i] = value;
+                buffer[offset + length] = terminator;
+
+                auto first = buffer.begin() + static_cast<std::ptrdiff_t>(offset);
+                auto last = rng::EndValue<terminator>{};
+
+                REQUIRE(rng::find(first, last, value) == std::ranges::find(first, last, value));
+                REQUIRE(rng::find(first, last, T{42}) == std::ranges::find(first, last, T{42}));
+                REQUIRE(rng::count(first, last, value) == std::ranges::count(first, last, value));
+                REQUIRE(rng::find(first, std::unreachable_sentinel, terminator) == buffer.begin() + static_cast<std::ptrdiff_t>(offset + length));
+
+                std::vector<T> copied;
+                auto [in, out] = rng::copy_until(first, last, std::back_inserter(copied));
+                REQUIRE(in == buffer.begin() + static_cast<std::ptrdiff_t>(offset + length));
+                REQUIRE(std::ranges::equal(copied, std::ranges::subrange(first, in)));
+            }
+    }
+} // namespace
+
+TEST_CASE("sentinel-aware search")
+{
+    SECTION("the same results as std::ranges algorithms")
+    {
+        check_against_std_ranges<char>();
+        check_against_std_ranges<std::uint16_t>();
+        check_against_std_ranges<int>();
+        check_against_std_ranges<std::int64_t>();
+        check_against_std_ranges<float>();
+        check_against_std_ranges<double>();
+    }
+
+    SECTION("EndValue from the sentinels example")
+    {
+        std::vector data = {2, 3, 4, 1, 5, 42, 6, 9, 8, 11, 10, 7};
+        std::ranges::sort(data.begin(), rng::EndValue<42>{});
+
+        REQUIRE(*rng::find(data.begin(), std::unreachable_sentinel, 42) == 42);
+        REQUIRE(rng::count(data.begin(), rng::EndValue<42>{}, 9) == 0); // 9 is after the terminator
+        REQUIRE(rng::find(std::ranges::subrange{data.begin(), rng::EndValue<42>{}}, 5) == data.begin() + 4);
+    }
+
+    SECTION("C strings")
+    {
+        const char* text = "abc, def, ghi";
+
+        REQUIRE(rng::count(text, rng::EndValue<'\0'>{}, ',') == 2);
+        REQUIRE(rng::find(text, rng::EndValue<'\0'>{}, 'x') == text + std::strlen(text));
+
+        std::string copy;
+        rng::copy_until(text, rng::EndValue<'\0'>{}, std::back_inserter(copy));
+        REQUIRE(copy == text);
+    }
+
+    SECTION("terminators changed by the conversion to the element type are not searched with SIMD")
+    {
+        static_assert(rng::detail::SimdEndValueRange<const unsigned char*, rng::EndValue<255>>);
+        static_assert(!rng::detail::SimdEndValueRange<const unsigned char*, rng::EndValue<-1>>); // never equal to an element
+        static_assert(!rng::detail::SimdEndValueRange<const char*, rng::EndValue<300>>);
+
+        const unsigned char bytes[] = {2, 1, 2, 255, 2};
+        REQUIRE(rng::count(bytes + 0, rng::EndValue<255>{}, static_cast<unsigned char>(2)) == 2);
+    }
+
+    SECTION("other iterators use the standard algorithms")
+    {
+        std::list<int> data = {1, 2, 3, 0, 2};
+
+        REQUIRE(rng::count(data.begin(), rng::EndValue<0>{}, 2) == 1);
+        REQUIRE(*rng::find(data.begin(), rng::EndValue<0>{}, 3) == 3);
+    }
+
+#ifdef __linux__
+    SECTION("no read past the page of the terminator")
+    {
+        const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        void* pages = ::mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        REQUIRE(pages != MAP_FAILED);
+        REQUIRE(::mprotect(static_cast<char*>(pages) + page_size, page_size, PROT_NONE) == 0);
+
+        // "xxx...x\0" ending at the last byte of the readable page
+        char* text = static_cast<char*>(pages) + page_size - 21;
+        std::memset(text, 'x', 20);
+        text[20] = '\0';
+
+        REQUIRE(rng::find(text, rng::EndValue<'\0'>{}, 'y') == text + 20);
+        REQUIRE(rng::count(text, rng::EndValue<'\0'>{}, 'x') == 20);
+        REQUIRE(*rng::find(text, std::unreachable_sentinel, '\0') == '\0');
+
+        ::munmap(pages, 2 * page_size);
+    }
+#endif
+}
+
+TEST_CASE("sentinel-aware search vs std::ranges", "[.][benchmark]")
+{
+    std::string text(1024 * 1024, 'a');
+    for (std::size_t i = 0; i < text.size(); i += 97)
+        text[i] = ',';
+
+    BENCHMARK("std::ranges::find - EndValue<'\\0'>")
+    {
+        return std::ranges::find(text.c_str(), rng::EndValue<'\0'>{}, 'x');
+    };
+
+    BENCHMARK("rng::find - EndValue<'\\0'>")
+    {
+        return rng::find(text.c_str(), rng::EndValue<'\0'>{}, 'x');
+    };
+
+    BENCHMARK("strlen")
+    {
+        return std::strlen(text.c_str());
+    };
+
+    BENCHMARK("std::ranges::count - EndValue<'\\0'>")
+    {
+        return std::ranges::count(text.c_str(), rng::EndValue<'\0'>{}, ',');
+    };
+
+    BENCHMARK("rng::count - EndValue<'\\0'>")
+    {
+        return rng::count(text.c_str(), rng::EndValue<'\0'>{}, ',');
+    };
+}
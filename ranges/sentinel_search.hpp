@@ -0,0 +1,223 @@
+#ifndef SENTINEL_SEARCH_HPP
+#define SENTINEL_SEARCH_HPP
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// aligned blocks may extend past the terminator (never past its page) - as in strlen/memchr
+#if defined(__GNUC__) || defined(__clang__)
+#define RNG_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define RNG_NO_SANITIZE_ADDRESS
+#endif
+
+namespace rng
+{
+    // sentinel of a range terminated by a value: std::ranges::sort(data.begin(), EndValue<42>{})
+    template <auto Value>
+    struct EndValue
+    {
+        static constexpr auto value = Value;
+
+        bool operator==(auto it) const
+        {
+            return *it == Value;
+        }
+    };
+
+    namespace detail
+    {
+        template <typename S>
+        constexpr bool is_end_value = false;
+
+        template <auto Value>
+        constexpr bool is_end_value<EndValue<Value>> = true;
+
+        template <typename T>
+        concept SimdElement = (std::integral<T> && !std::same_as<T, bool> && sizeof(T) <= 8) || std::same_as<T, float> || std::same_as<T, double>;
+
+        template <typename It>
+        concept SimdIterator = std::contiguous_iterator<It> && SimdElement<std::iter_value_t<It>>;
+
+        // the SIMD compare sees the terminator converted to the element type - it must find the same elements as
+        // *it == S::value (e.g. not EndValue<-1> over unsigned char, which never matches, but 0xFF after the conversion)
+        template <typename V, auto Value>
+        constexpr bool keeps_value = static_cast<V>(Value) == Value;
+
+        // end of a contiguous range is known only from its contents
+        template <typename It, typename S>
+        concept SimdEndValueRange = SimdIterator<It> && is_end_value<S> && keeps_value<std::iter_value_t<It>, S::value>;
+
+        template <typename It, typename S>
+        concept SimdUnboundedRange = SimdIterator<It> && std::same_as<S, std::unreachable_sentinel_t>;
+
+#ifdef __SSE2__
+        constexpr std::size_t block_size = 16;
+
+        // byte mask of the elements of an aligned block equal to value
+        template <typename T>
+        RNG_NO_SANITIZE_ADDRESS std::uint32_t equal_mask(const std::byte* block, T value) noexcept
+        {
+            const __m128i data = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+            __m128i eq;
+
+            if constexpr (std::same_as<T, float>)
+                eq = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(data), _mm_set1_ps(value)));
+            else if constexpr (std::same_as<T, double>)
+                eq = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(data), _mm_set1_pd(value)));
+            else if constexpr (sizeof(T) == 1)
+                eq = _mm_cmpeq_epi8(data, _mm_set1_epi8(static_cast<char>(value)));
+            else if constexpr (sizeof(T) == 2)
+                eq = _mm_cmpeq_epi16(data, _mm_set1_epi16(static_cast<short>(value)));
+            else if constexpr (sizeof(T) == 4)
+                eq = _mm_cmpeq_epi32(data, _mm_set1_epi32(static_cast<int>(value)));
+            else
+            {
+                // SSE2 has no 64-bit compare - both 32-bit halves must be equal
+                const __m128i eq32 = _mm_cmpeq_epi32(data, _mm_set1_epi64x(static_cast<long long>(value)));
+                eq = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(eq));
+        }
+
+        // aligned block containing ptr and the mask of its bytes at or after ptr
+        inline std::pair<const std::byte*, std::uint32_t> first_block(const void* ptr) noexcept
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            const auto offset = static_cast<unsigned>(address % block_size);
+            return {static_cast<const std::byte*>(ptr) - offset, ~std::uint32_t{0} << offset};
+        }
+#endif
+
+        // first element equal to a or b - one of them must be present
+        template <typename T>
+        const T* find_either(const T* first, T a, T b) noexcept
+        {
+#ifdef __SSE2__
+            auto [block, valid] = first_block(first);
+            for (;; block += block_size, valid = ~std::uint32_t{0})
+            {
+                if (const std::uint32_t bits = (equal_mask(block, a) | equal_mask(block, b)) & valid)
+                    return reinterpret_cast<const T*>(block + std::countr_zero(bits));
+            }
+#else
+            while (!(*first == a || *first == b))
+                ++first;
+            return first;
+#endif
+        }
+
+        // elements equal to value before the terminator
+        template <typename T>
+        std::size_t count_until(const T* first, T value, T terminator) noexcept
+        {
+#ifdef __SSE2__
+            std::size_t count = 0;
+            auto [block, valid] = first_block(first);
+            for (;; block += block_size, valid = ~std::uint32_t{0})
+            {
+                const std::uint32_t matches = equal_mask(block, value) & valid;
+                if (const std::uint32_t end = equal_mask(block, terminator) & valid)
+                {
+                    const std::uint32_t before_end = (end & -end) - 1; // bytes below the first terminator
+                    return count + static_cast<std::size_t>(std::popcount(matches & before_end)) / sizeof(T);
+                }
+                count += static_cast<std::size_t>(std::popcount(matches)) / sizeof(T);
+            }
+#else
+            std::size_t count = 0;
+            for (; !(*first == terminator); ++first)
+                count += (*first == value);
+            return count;
+#endif
+        }
+
+        template <typename It>
+        It to_iterator(It first, const std::iter_value_t<It>* ptr) noexcept
+        {
+            return first + (ptr - std::to_address(first));
+        }
+    } // namespace detail
+
+    // find for value-terminated and unbounded ranges - contiguous ranges of arithmetic types searched for a value
+    // of the same type are scanned in aligned SIMD blocks, anything else falls back to std::ranges::find
+    template <std::input_iterator It, std::sentinel_for<It> S, typename T>
+    It find(It first, S last, const T& value)
+    {
+        if constexpr (detail::SimdEndValueRange<It, S> && std::same_as<T, std::iter_value_t<It>>)
+        {
+            using V = std::iter_value_t<It>;
+            // the first value or the terminator - the latter means not found, as for std::ranges::find
+            return detail::to_iterator(first, detail::find_either(std::to_address(first), static_cast<V>(value), static_cast<V>(S::value)));
+        }
+        else if constexpr (detail::SimdUnboundedRange<It, S> && std::same_as<T, std::iter_value_t<It>>)
+        {
+            using V = std::iter_value_t<It>;
+            return detail::to_iterator(first, detail::find_either(std::to_address(first), static_cast<V>(value), static_cast<V>(value)));
+        }
+        else
+            return std::ranges::find(first, last, value);
+    }
+
+    template <std::ranges::input_range R, typename T>
+    std::ranges::borrowed_iterator_t<R> find(R&& range, const T& value)
+    {
+        return rng::find(std::ranges::begin(range), std::ranges::end(range), value);
+    }
+
+    template <std::input_iterator It, std::sentinel_for<It> S, typename T>
+    std::iter_difference_t<It> count(It first, S last, const T& value)
+    {
+        if constexpr (detail::SimdEndValueRange<It, S> && std::same_as<T, std::iter_value_t<It>>)
+        {
+            using V = std::iter_value_t<It>;
+            return static_cast<std::iter_difference_t<It>>(detail::count_until(std::to_address(first), static_cast<V>(value), static_cast<V>(S::value)));
+        }
+        else
+            return std::ranges::count(first, last, value);
+    }
+
+    template <std::ranges::input_range R, typename T>
+    std::ranges::range_difference_t<R> count(R&& range, const T& value)
+    {
+        return rng::count(std::ranges::begin(range), std::ranges::end(range), value);
+    }
+
+    // copies the elements before the terminator - the terminator is located first, then copied as a block
+    template <std::input_iterator It, std::sentinel_for<It> S, std::weakly_incrementable Out>
+        requires std::indirectly_copyable<It, Out>
+    std::ranges::copy_result<It, Out> copy_until(It first, S last, Out out)
+    {
+        if constexpr (detail::SimdEndValueRange<It, S>)
+        {
+            using V = std::iter_value_t<It>;
+            const V* terminator = detail::find_either(std::to_address(first), static_cast<V>(S::value), static_cast<V>(S::value));
+            const It end = detail::to_iterator(first, terminator);
+            return {end, std::ranges::copy(first, end, std::move(out)).out};
+        }
+        else
+            return std::ranges::copy(std::move(first), std::move(last), std::move(out));
+    }
+
+    template <std::ranges::input_range R, std::weakly_incrementable Out>
+        requires std::indirectly_copyable<std::ranges::iterator_t<R>, Out>
+    std::ranges::copy_result<std::ranges::borrowed_iterator_t<R>, Out> copy_until(R&& range, Out out)
+    {
+        return rng::copy_until(std::ranges::begin(range), std::ranges::end(range), std::move(out));
+    }
+} // namespace rng
+
+#endif
@@ -0,0 +1,172 @@
+#include "top_k.hpp"
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <helpers.hpp>
+#include <thread_pool.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Person
+    {
+        int id;
+        std::string name;
+        double salary;
+    };
+
+    template <typename T>
+    std::vector<T> create_values(std::size_t count, std::uint32_t seed = 42)
+    {
+        std::mt19937 rnd{seed};
+        std::uniform_int_distribution<int> distr{-1'000'000, 1'000'000};
+        std::vector<T> values(count);
+        std::ranges::generate(values, [&] { return static_cast<T>(distr(rnd)); });
+        return values;
+    }
+
+    template <typename T, typename Comp = std::ranges::greater>
+    std::vector<T> expected_top_k(const std::vector<T>& data, std::size_t k, Comp comp = {})
+    {
+        std::vector<T> result(std::min(k, data.size()));
+        std::ranges::partial_sort_copy(data, result, comp);
+        return result;
+    }
+} // namespace
+
+TEST_CASE("top_k")
+{
+    const auto data = create_values<int>(10'000);
+
+    SECTION("the k largest by default")
+    {
+        REQUIRE(rng::top_k(data, 10) == expected_top_k(data, 10));
+    }
+
+    SECTION("the k smallest")
+    {
+        REQUIRE(rng::top_k(data, 10, std::less{}) == expected_top_k(data, 10, std::less{}));
+    }
+
+    SECTION("k larger than the range & k == 0")
+    {
+        std::vector small = {3, 1, 2};
+        REQUIRE(rng::top_k(small, 5) == std::vector{3, 2, 1});
+        REQUIRE(rng::top_k(small, 0).empty());
+
+        const auto all = rng::top_k(small, std::numeric_limits<std::size_t>::max());
+        REQUIRE(all == std::vector{3, 2, 1});
+        REQUIRE(all.capacity() == small.size());
+
+        auto is_odd = [](int x) { return x % 2 != 0; };
+        REQUIRE(rng::top_k(small | std::views::filter(is_odd), std::numeric_limits<std::size_t>::max()) == std::vector{3, 1});
+    }
+
+    SECTION("end of a pipeline")
+    {
+        auto is_even = [](int x) { return x % 2 == 0; };
+
+        auto result = data | std::views::filter(is_even) | rng::top_k(5);
+
+        std::vector<int> evens;
+        std::ranges::copy_if(data, std::back_inserter(evens), is_even);
+        REQUIRE(result == expected_top_k(evens, 5));
+    }
+
+    SECTION("single-pass input")
+    {
+        std::istringstream input{"5 8 1 9 3 7"};
+        REQUIRE(rng::top_k(std::views::istream<int>(input), 3) == std::vector{9, 8, 7});
+    }
+
+    SECTION("projection")
+    {
+        std::vector<Person> people = {{1, "Jan", 5'000.0}, {2, "Adam", 7'500.0}, {3, "Ewa", 6'100.0}, {4, "Zenon", 4'000.0}};
+
+        auto best_paid = rng::top_k(people, 2, std::greater{}, &Person::salary);
+
+        REQUIRE(best_paid.size() == 2);
+        REQUIRE(best_paid[0].name == "Adam");
+        REQUIRE(best_paid[1].name == "Ewa");
+    }
+}
+
+TEST_CASE("top_k - SIMD threshold filter")
+{
+    for (std::size_t size : {0u, 7u, 100u, 1'001u})
+    {
+        for (std::size_t k : {1u, 3u, 50u})
+        {
+            const auto ints = create_values<int>(size, static_cast<std::uint32_t>(size + k));
+            REQUIRE(rng::top_k(ints, k) == expected_top_k(ints, k));
+            REQUIRE(rng::top_k(ints, k, std::less<int>{}) == expected_top_k(ints, k, std::less{}));
+
+            const auto floats = create_values<float>(size, static_cast<std::uint32_t>(size * k));
+            REQUIRE(rng::top_k(floats, k, std::greater<>{}) == expected_top_k(floats, k));
+
+            const auto doubles = create_values<double>(size, static_cast<std::uint32_t>(size));
+            REQUIRE(rng::top_k(doubles, k, std::ranges::less{}) == expected_top_k(doubles, k, std::less{}));
+        }
+    }
+}
+
+TEST_CASE("top_k - parallel")
+{
+    helpers::ThreadPool pool{4};
+    rng::ParallelPolicy policy{pool, 4, 100};
+
+    const auto data = create_values<int>(100'000);
+
+    REQUIRE(rng::top_k(policy, data, 20) == expected_top_k(data, 20));
+    REQUIRE(rng::top_k(policy, data, 20, std::less{}) == expected_top_k(data, 20, std::less{}));
+
+    auto squares = std::views::iota(-5'000, 5'000) | std::views::transform([](int x) { return x * x; });
+    REQUIRE(rng::top_k(policy, squares, 3, std::less{}) == std::vector{0, 1, 1});
+}
+
+TEST_CASE("top_k vs sorting", "[.][benchmark]")
+{
+    helpers::ThreadPool pool;
+    rng::ParallelPolicy policy{pool};
+
+    const auto data = create_values<int>(4'000'000);
+    constexpr std::size_t k = 10;
+
+    BENCHMARK("sort & take")
+    {
+        auto copy = data;
+        std::ranges::sort(copy, std::greater{});
+        copy.resize(k);
+        return copy;
+    };
+
+    BENCHMARK("partial_sort_copy")
+    {
+        std::vector<int> result(k);
+        std::ranges::partial_sort_copy(data, result, std::greater{});
+        return result;
+    };
+
+    BENCHMARK("top_k - scalar (filter view)")
+    {
+        return data | std::views::filter([](int) { return true; }) | rng::top_k(k);
+    };
+
+    BENCHMARK("top_k - SIMD threshold")
+    {
+        return rng::top_k(data, k);
+    };
+
+    BENCHMARK("top_k - parallel, " + std::to_string(pool.size()) + " threads")
+    {
+        return rng::top_k(policy, data, k);
+    };
+}
@@ -0,0 +1,246 @@
+#ifndef TOP_K_HPP
+#define TOP_K_HPP
+
+#include "par_chunks.hpp"
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace rng
+{
+    namespace detail
+    {
+        // the k first elements in the order of comp seen so far - the front of the heap is the last of them,
+        // i.e. the threshold a new element has to beat
+        template <typename T, typename Comp, typename Proj>
+        class BoundedHeap
+        {
+        public:
+            // reserved for the expected number of pushes (0 if unknown) - k alone may be far larger than the input
+            BoundedHeap(std::size_t k, std::size_t expected_size, Comp& comp, Proj& proj)
+                : k_{k}
+                , comp_{comp}
+                , proj_{proj}
+            {
+                items_.reserve(std::min(k, expected_size));
+            }
+
+            bool full() const noexcept
+            {
+                return items_.size() == k_;
+            }
+
+            const T& threshold() const noexcept
+            {
+                return items_.front();
+            }
+
+            template <typename U>
+            void push(U&& value)
+            {
+                if (items_.size() < k_)
+                {
+                    items_.emplace_back(std::forward<U>(value));
+                    std::ranges::push_heap(items_, std::ref(comp_), std::ref(proj_));
+                }
+                else if (k_ > 0 && std::invoke(comp_, std::invoke(proj_, value), std::invoke(proj_, items_.front())))
+                {
+                    std::ranges::pop_heap(items_, std::ref(comp_), std::ref(proj_));
+                    items_.back() = std::forward<U>(value);
+                    std::ranges::push_heap(items_, std::ref(comp_), std::ref(proj_));
+                }
+            }
+
+            std::vector<T> take_sorted() &&
+            {
+                std::ranges::sort_heap(items_, std::ref(comp_), std::ref(proj_));
+                return std::move(items_);
+            }
+
+        private:
+            std::size_t k_;
+            Comp& comp_;
+            Proj& proj_;
+            std::vector<T> items_;
+        };
+
+        template <typename Comp>
+        constexpr bool is_less = std::same_as<Comp, std::ranges::less> || std::same_as<Comp, std::less<>>;
+
+        template <typename Comp>
+        constexpr bool is_greater = std::same_as<Comp, std::ranges::greater> || std::same_as<Comp, std::greater<>>;
+
+        // elements compared with the threshold in SIMD blocks - blocks without a candidate are skipped
+        template <typename T, typename Comp>
+        concept SimdThreshold = (std::same_as<T, int> || std::same_as<T, float> || std::same_as<T, double>)
+            && (is_less<Comp> || is_greater<Comp> || std::same_as<Comp, std::less<T>> || std::same_as<Comp, std::greater<T>>);
+
+#ifdef __SSE2__
+        constexpr std::size_t threshold_block_bytes = 64;
+
+        // true if any element of the 64-byte block is before the threshold in the order of comp
+        template <bool Greater, typename T>
+        bool any_beats(const T* block, T threshold) noexcept
+        {
+            if constexpr (std::same_as<T, int>)
+            {
+                const __m128i t = _mm_set1_epi32(threshold);
+                __m128i hits = _mm_setzero_si128();
+                for (int i = 0; i < 4; ++i)
+                {
+                    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block) + i);
+                    hits = _mm_or_si128(hits, Greater ? _mm_cmpgt_epi32(v, t) : _mm_cmplt_epi32(v, t));
+                }
+                return _mm_movemask_epi8(hits) != 0;
+            }
+            else if constexpr (std::same_as<T, float>)
+            {
+                const __m128 t = _mm_set1_ps(threshold);
+                __m128 hits = _mm_setzero_ps();
+                for (int i = 0; i < 4; ++i)
+                {
+                    const __m128 v = _mm_loadu_ps(block + 4 * i);
+                    hits = _mm_or_ps(hits, Greater ? _mm_cmpgt_ps(v, t) : _mm_cmplt_ps(v, t));
+                }
+                return _mm_movemask_ps(hits) != 0;
+            }
+            else
+            {
+                const __m128d t = _mm_set1_pd(threshold);
+                __m128d hits = _mm_setzero_pd();
+                for (int i = 0; i < 4; ++i)
+                {
+                    const __m128d v = _mm_loadu_pd(block + 2 * i);
+                    hits = _mm_or_pd(hits, Greater ? _mm_cmpgt_pd(v, t) : _mm_cmplt_pd(v, t));
+                }
+                return _mm_movemask_pd(hits) != 0;
+            }
+        }
+#endif
+
+        template <typename R, typename Comp, typename Proj>
+        std::vector<std::ranges::range_value_t<R>> top_k(R&& range, std::size_t k, Comp& comp, Proj& proj)
+        {
+            using Value = std::ranges::range_value_t<R>;
+
+            std::size_t expected_size = 0; // the heap grows as needed
+            if constexpr (std::ranges::sized_range<R>)
+                expected_size = static_cast<std::size_t>(std::ranges::size(range));
+
+            BoundedHeap<Value, Comp, Proj> heap{k, expected_size, comp, proj};
+
+            if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && SimdThreshold<Value, Comp> && std::same_as<Proj, std::identity>)
+            {
+                const Value* first = std::ranges::data(range);
+                const Value* last = first + std::ranges::size(range);
+
+                for (; first != last && !heap.full(); ++first)
+                    heap.push(*first);
+
+#ifdef __SSE2__
+                constexpr std::size_t block = threshold_block_bytes / sizeof(Value);
+                constexpr bool greater = is_greater<Comp> || std::same_as<Comp, std::greater<Value>>;
+
+                if (k > 0)
+                {
+                    for (; static_cast<std::size_t>(last - first) >= block; first += block)
+                    {
+                        if (any_beats<greater>(first, heap.threshold()))
+                        {
+                            for (std::size_t i = 0; i < block; ++i)
+                                heap.push(first[i]);
+                        }
+                    }
+                }
+#endif
+                for (; first != last; ++first)
+                    heap.push(*first);
+            }
+            else
+            {
+                for (auto&& item : range)
+                    heap.push(std::forward<decltype(item)>(item));
+            }
+
+            return std::move(heap).take_sorted();
+        }
+
+        template <typename Comp, typename Proj>
+        struct TopKAdaptor
+        {
+            std::size_t k;
+            Comp comp;
+            Proj proj;
+
+            template <std::ranges::input_range R>
+            friend auto operator|(R&& range, TopKAdaptor adaptor)
+            {
+                return detail::top_k(std::forward<R>(range), adaptor.k, adaptor.comp, adaptor.proj);
+            }
+        };
+    } // namespace detail
+
+    // the first k elements in the order of comp - by default the k largest - in a single pass with O(k) memory;
+    // the result is sorted as by std::ranges::partial_sort_copy (equivalent elements in no particular order)
+    //   auto best = rng::top_k(people, 3, std::greater{}, &Person::salary);
+    //   auto best = data | views::filter(is_valid) | rng::top_k(10);
+    template <std::ranges::input_range R, typename Comp = std::ranges::greater, typename Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, std::projected<std::ranges::iterator_t<R>, Proj>>
+    std::vector<std::ranges::range_value_t<R>> top_k(R&& range, std::size_t k, Comp comp = {}, Proj proj = {})
+    {
+        return detail::top_k(std::forward<R>(range), k, comp, proj);
+    }
+
+    template <typename Comp = std::ranges::greater, typename Proj = std::identity>
+    detail::TopKAdaptor<Comp, Proj> top_k(std::size_t k, Comp comp = {}, Proj proj = {})
+    {
+        return {k, std::move(comp), std::move(proj)};
+    }
+
+    // chunks of the range processed on the thread pool - the per-chunk results (at most k each) are merged at the end
+    template <ChunkableRange R, typename Comp = std::ranges::greater, typename Proj = std::identity>
+        requires std::indirect_strict_weak_order<Comp, std::projected<std::ranges::iterator_t<R>, Proj>>
+    std::vector<std::ranges::range_value_t<R>> top_k(const ParallelPolicy& policy, R&& range, std::size_t k, Comp comp = {}, Proj proj = {})
+    {
+        using Value = std::ranges::range_value_t<R>;
+
+        const auto size = static_cast<std::size_t>(std::ranges::distance(range));
+        const std::size_t max_chunks = std::max<std::size_t>(1, size / std::max<std::size_t>(1, policy.min_chunk_size));
+        const auto chunks = par_chunks(range, std::min(policy.pool.size() * policy.chunks_per_thread, max_chunks));
+
+        if (chunks.size() == 1)
+            return detail::top_k(chunks.front(), k, comp, proj);
+
+        std::vector<std::vector<Value>> partial(chunks.size());
+        detail::run_on_pool(policy.pool, chunks.size(), [&](std::size_t i) {
+            Comp chunk_comp = comp;
+            Proj chunk_proj = proj;
+            partial[i] = detail::top_k(chunks[i], k, chunk_comp, chunk_proj);
+        });
+
+        std::size_t partial_size = 0;
+        for (const auto& part : partial)
+            partial_size += part.size();
+
+        detail::BoundedHeap<Value, Comp, Proj> heap{k, partial_size, comp, proj};
+        for (auto& part : partial)
+        {
+            for (auto& item : part)
+                heap.push(std::move(item));
+        }
+        return std::move(heap).take_sorted();
+    }
+} // namespace rng
+
+#endif